@@ -105,6 +105,7 @@ bool		g_cube_internal_consistent(NDBOX *key, NDBOX *query, StrategyNumber strate
 ** Auxiliary functions
 */
 static double distance_1D(double a1, double a2, double b1, double b2);
+static inline double point_distance_1D(double a, double b);
 static bool cube_is_point_internal(NDBOX *cube);
 
 
@@ -1269,18 +1270,38 @@ cube_distance(PG_FUNCTION_ARGS)
 	}
 
 	distance = 0.0;
-	/* compute within the dimensions of (b) */
-	for (i = 0; i < DIM(b); i++)
+	if (IS_POINT(a) && IS_POINT(b))
 	{
-		d = distance_1D(LL_COORD(a, i), UR_COORD(a, i), LL_COORD(b, i), UR_COORD(b, i));
-		distance += d * d;
+		/*
+		 * Fast path for two points, which is the common case in nearest
+		 * neighbor searches: there are no upper right corners to look at.
+		 */
+		for (i = 0; i < DIM(b); i++)
+		{
+			d = point_distance_1D(a->x[i], b->x[i]);
+			distance += d * d;
+		}
+		for (i = DIM(b); i < DIM(a); i++)
+		{
+			d = point_distance_1D(a->x[i], 0.0);
+			distance += d * d;
+		}
 	}
-
-	/* compute distance to zero for those dimensions in (a) absent in (b) */
-	for (i = DIM(b); i < DIM(a); i++)
+	else
 	{
-		d = distance_1D(LL_COORD(a, i), UR_COORD(a, i), 0.0, 0.0);
-		distance += d * d;
+		/* compute within the dimensions of (b) */
+		for (i = 0; i < DIM(b); i++)
+		{
+			d = distance_1D(LL_COORD(a, i), UR_COORD(a, i), LL_COORD(b, i), UR_COORD(b, i));
+			distance += d * d;
+		}
+
+		/* compute distance to zero for those dimensions in (a) absent in (b) */
+		for (i = DIM(b); i < DIM(a); i++)
+		{
+			d = distance_1D(LL_COORD(a, i), UR_COORD(a, i), 0.0, 0.0);
+			distance += d * d;
+		}
 	}
 
 	if (swapped)
@@ -1317,15 +1338,26 @@ distance_taxicab(PG_FUNCTION_ARGS)
 	}
 
 	distance = 0.0;
-	/* compute within the dimensions of (b) */
-	for (i = 0; i < DIM(b); i++)
-		distance += fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
-									 LL_COORD(b, i), UR_COORD(b, i)));
-
-	/* compute distance to zero for those dimensions in (a) absent in (b) */
-	for (i = DIM(b); i < DIM(a); i++)
-		distance += fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
-									 0.0, 0.0));
+	if (IS_POINT(a) && IS_POINT(b))
+	{
+		/* fast path for two points, see cube_distance() */
+		for (i = 0; i < DIM(b); i++)
+			distance += point_distance_1D(a->x[i], b->x[i]);
+		for (i = DIM(b); i < DIM(a); i++)
+			distance += point_distance_1D(a->x[i], 0.0);
+	}
+	else
+	{
+		/* compute within the dimensions of (b) */
+		for (i = 0; i < DIM(b); i++)
+			distance += fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
+										 LL_COORD(b, i), UR_COORD(b, i)));
+
+		/* compute distance to zero for those dimensions in (a) absent in (b) */
+		for (i = DIM(b); i < DIM(a); i++)
+			distance += fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
+										 0.0, 0.0));
+	}
 
 	if (swapped)
 	{
@@ -1362,21 +1394,40 @@ distance_chebyshev(PG_FUNCTION_ARGS)
 	}
 
 	distance = 0.0;
-	/* compute within the dimensions of (b) */
-	for (i = 0; i < DIM(b); i++)
+	if (IS_POINT(a) && IS_POINT(b))
 	{
-		d = fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
-							 LL_COORD(b, i), UR_COORD(b, i)));
-		if (d > distance)
-			distance = d;
+		/* fast path for two points, see cube_distance() */
+		for (i = 0; i < DIM(b); i++)
+		{
+			d = point_distance_1D(a->x[i], b->x[i]);
+			if (d > distance)
+				distance = d;
+		}
+		for (i = DIM(b); i < DIM(a); i++)
+		{
+			d = point_distance_1D(a->x[i], 0.0);
+			if (d > distance)
+				distance = d;
+		}
 	}
-
-	/* compute distance to zero for those dimensions in (a) absent in (b) */
-	for (i = DIM(b); i < DIM(a); i++)
+	else
 	{
-		d = fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i), 0.0, 0.0));
-		if (d > distance)
-			distance = d;
+		/* compute within the dimensions of (b) */
+		for (i = 0; i < DIM(b); i++)
+		{
+			d = fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i),
+								 LL_COORD(b, i), UR_COORD(b, i)));
+			if (d > distance)
+				distance = d;
+		}
+
+		/* compute distance to zero for those dimensions in (a) absent in (b) */
+		for (i = DIM(b); i < DIM(a); i++)
+		{
+			d = fabs(distance_1D(LL_COORD(a, i), UR_COORD(a, i), 0.0, 0.0));
+			if (d > distance)
+				distance = d;
+		}
 	}
 
 	if (swapped)
@@ -1513,6 +1564,22 @@ distance_1D(double a1, double a2, double b1, double b2)
 	return 0.0;
 }
 
+/*
+ * Distance between two points along one dimension.  This is what
+ * distance_1D() returns for two degenerate intervals [a,a] and [b,b],
+ * including returning zero if either is NaN, without its comparisons
+ * between the bounds of each interval.
+ */
+static inline double
+point_distance_1D(double a, double b)
+{
+	if (a <= b)
+		return b - a;
+	if (a > b)
+		return a - b;
+	return 0.0;
+}
+
 /* Test if a box is also a point */
 Datum
 cube_is_point(PG_FUNCTION_ARGS)
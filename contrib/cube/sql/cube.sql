@@ -350,6 +350,14 @@ SELECT '(1,1)'::cube <#> '(4,5)'::cube as d_t;
 SELECT cube_distance('(2,2),(10,10)'::cube, '(0,0),(5,5)'::cube);
 SELECT distance_chebyshev('(2,2),(10,10)'::cube, '(0,0),(5,5)'::cube);
 SELECT distance_taxicab('(2,2),(10,10)'::cube, '(0,0),(5,5)'::cube);
+-- points of different dimensionality; missing coordinates are zero
+SELECT cube_distance('(1,1)'::cube, '(4,5,12)'::cube);
+SELECT cube_distance('(4,5,12)'::cube, '(1,1)'::cube);
+SELECT cube_distance('(1,1)'::cube, '(4,5,12),(4,5,13)'::cube);
+SELECT distance_chebyshev('(1,1)'::cube, '(4,5,-12)'::cube);
+SELECT distance_chebyshev('(4,5,-12)'::cube, '(1,1)'::cube);
+SELECT distance_taxicab('(1,1)'::cube, '(4,5,-12)'::cube);
+SELECT distance_taxicab('(4,5,-12)'::cube, '(1,1)'::cube);
 -- coordinate access
 SELECT cube(array[10,20,30], array[40,50,60])->1;
 SELECT cube(array[40,50,60], array[10,20,30])->1;
@@ -170,6 +170,19 @@ commit;
 select * from pg_visibility_map('copyfreeze');
 select * from pg_check_frozen('copyfreeze');
 
+-- Opportunistic pruning, when a scan reads a page with an old update on it,
+-- also sets the page all-visible if everything left on it is visible to
+-- everyone.  With fillfactor 10, each row gets a page of its own, and the
+-- update leaves too little free space on its page not to prune it.
+create table prunevm (a int, b text)
+  with (fillfactor = 10, autovacuum_enabled = false);
+insert into prunevm select i, repeat('x', 500) from generate_series(1, 3) i;
+update prunevm set a = a + 10 where a = 2;
+select * from pg_visibility('prunevm');
+select count(*) from prunevm;
+select * from pg_visibility('prunevm');
+select * from pg_check_visible('prunevm');
+
 -- cleanup
 drop table test_partitioned;
 drop view test_view;
@@ -180,3 +193,4 @@ drop foreign data wrapper dummy;
 drop materialized view matview_visibility_test;
 drop table regular_table;
 drop table copyfreeze;
+drop table prunevm;
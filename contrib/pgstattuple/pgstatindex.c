@@ -125,6 +125,10 @@ typedef struct HashIndexStat
 	int64		live_items;
 	int64		dead_items;
 	uint64		free_space;
+
+	/* buckets in the middle of a split, and awaiting cleanup after one */
+	int64		incomplete_splits;
+	int64		split_cleanup_buckets;
 } HashIndexStat;
 
 static Datum pgstatindex_impl(Relation rel, FunctionCallInfo fcinfo);
@@ -574,8 +578,8 @@ pgstathashindex(PG_FUNCTION_ARGS)
 	BufferAccessStrategy bstrategy;
 	HeapTuple	tuple;
 	TupleDesc	tupleDesc;
-	Datum		values[8];
-	bool		nulls[8];
+	Datum		values[10];
+	bool		nulls[10];
 	Buffer		metabuf;
 	HashMetaPage metap;
 	float8		free_percent;
@@ -647,6 +651,10 @@ pgstathashindex(PG_FUNCTION_ARGS)
 			if (pagetype == LH_BUCKET_PAGE)
 			{
 				stats.bucket_pages++;
+				if (H_BUCKET_BEING_SPLIT(opaque))
+					stats.incomplete_splits++;
+				if (H_NEEDS_SPLIT_CLEANUP(opaque))
+					stats.split_cleanup_buckets++;
 				GetHashPageStats(page, &stats);
 			}
 			else if (pagetype == LH_OVERFLOW_PAGE)
@@ -695,7 +703,9 @@ pgstathashindex(PG_FUNCTION_ARGS)
 	tupleDesc = BlessTupleDesc(tupleDesc);
 
 	/*
-	 * Build and return the tuple
+	 * Build and return the tuple.  Versions before 1.6 of the extension
+	 * declare only the first eight output columns; heap_form_tuple() ignores
+	 * the rest in that case.
 	 */
 	MemSet(nulls, 0, sizeof(nulls));
 	values[0] = Int32GetDatum(stats.version);
@@ -706,6 +716,8 @@ pgstathashindex(PG_FUNCTION_ARGS)
 	values[5] = Int64GetDatum(stats.live_items);
 	values[6] = Int64GetDatum(stats.dead_items);
 	values[7] = Float8GetDatum(free_percent);
+	values[8] = Int64GetDatum(stats.incomplete_splits);
+	values[9] = Int64GetDatum(stats.split_cleanup_buckets);
 	tuple = heap_form_tuple(tupleDesc, values, nulls);
 
 	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
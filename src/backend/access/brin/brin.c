@@ -19,20 +19,24 @@
 #include "access/brin_page.h"
 #include "access/brin_pageops.h"
 #include "access/brin_xlog.h"
+#include "access/parallelbuild.h"
 #include "access/relation.h"
 #include "access/reloptions.h"
 #include "access/relscan.h"
 #include "access/table.h"
 #include "access/tableam.h"
 #include "access/xloginsert.h"
+#include "catalog/catalog.h"
 #include "catalog/index.h"
 #include "catalog/pg_am.h"
+#include "commands/progress.h"
 #include "commands/vacuum.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "postmaster/autovacuum.h"
 #include "storage/bufmgr.h"
 #include "storage/freespace.h"
+#include "storage/lmgr.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
 #include "utils/datum.h"
@@ -69,11 +73,40 @@ typedef struct BrinOpaque
 
 #define BRIN_ALL_BLOCKRANGES	InvalidBlockNumber
 
+/*
+ * Number of heap blocks a participant of a parallel build claims at a time
+ * (rounded up to a whole number of page ranges).
+ */
+#define BRIN_PARALLEL_CHUNK_BLOCKS		256
+
+/*
+ * Status for index builds performed in parallel.  This is allocated in a
+ * dynamic shared memory segment.
+ *
+ * Unlike a parallel B-tree build, there is no sort: each participant claims
+ * chunks of whole page ranges, scans them, and inserts their summary tuples
+ * into the index directly.  Since no page range is split between
+ * participants, no summary tuples need to be merged afterwards.
+ */
+typedef struct BrinShared
+{
+	IndexBuildShared common;	/* must be first */
+
+	/* These fields are not modified during the build */
+	BlockNumber nblocks;		/* number of heap blocks to summarize */
+	BlockNumber chunkblocks;	/* heap blocks claimed at a time */
+
+	/* Next heap block to be claimed by a participant; protected by mutex */
+	BlockNumber nextblock;
+} BrinShared;
+
 static BrinBuildState *initialize_brin_buildstate(Relation idxRel,
 												  BrinRevmap *revmap, BlockNumber pagesPerRange);
 static void terminate_brin_buildstate(BrinBuildState *state);
 static void brinsummarize(Relation index, Relation heapRel, BlockNumber pageRange,
 						  bool include_partial, double *numSummarized, double *numExisting);
+static bool brin_summarize_inline(Relation index, Relation heapRel,
+								  BlockNumber pageRange);
 static void form_and_insert_tuple(BrinBuildState *state);
 static void union_tuples(BrinDesc *bdesc, BrinMemTuple *a,
 						 BrinTuple *b);
@@ -81,6 +114,12 @@ static void brin_vacuum_scan(Relation idxrel, BufferAccessStrategy strategy);
 static bool add_values_to_range(Relation idxRel, BrinDesc *bdesc,
 								BrinMemTuple *dtup, Datum *values, bool *nulls);
 static bool check_null_keys(BrinValues *bval, ScanKey *nullkeys, int nnullkeys);
+static IndexBuildLeader *_brin_begin_parallel(Relation heap, Relation index,
+											  BlockNumber pagesPerRange,
+											  int request);
+static void _brin_parallel_build_ranges(BrinShared *brinshared,
+										BrinBuildState *state, Relation heap,
+										IndexInfo *indexInfo, bool progress);
 
 /*
  * BRIN handler function: return IndexAmRoutine with access method parameters
@@ -108,6 +147,7 @@ brinhandler(PG_FUNCTION_ARGS)
 	amroutine->amcanparallel = false;
 	amroutine->amcaninclude = false;
 	amroutine->amusemaintenanceworkmem = false;
+	amroutine->amsummarizing = true;
 	amroutine->amparallelvacuumoptions =
 		VACUUM_OPTION_PARALLEL_CLEANUP;
 	amroutine->amkeytype = InvalidOid;
@@ -166,6 +206,7 @@ brininsert(Relation idxRel, Datum *values, bool *nulls,
 	MemoryContext tupcxt = NULL;
 	MemoryContext oldcxt = CurrentMemoryContext;
 	bool		autosummarize = BrinGetAutoSummarize(idxRel);
+	bool		inlinesummarize = BrinGetInlineSummarize(idxRel);
 
 	revmap = brinRevmapInitialize(idxRel, &pagesPerRange, NULL);
 
@@ -188,9 +229,11 @@ brininsert(Relation idxRel, Datum *values, bool *nulls,
 		/*
 		 * If auto-summarization is enabled and we just inserted the first
 		 * tuple into the first block of a new non-first page range, request a
-		 * summarization run of the previous range.
+		 * summarization run of the previous range.  With inline summarization
+		 * we try to summarize it right here instead, so that the range can
+		 * be used by scans as soon as it's filled.
 		 */
-		if (autosummarize &&
+		if ((autosummarize || inlinesummarize) &&
 			heapBlk > 0 &&
 			heapBlk == origHeapBlk &&
 			ItemPointerGetOffsetNumber(heaptid) == FirstOffsetNumber)
@@ -203,17 +246,24 @@ brininsert(Relation idxRel, Datum *values, bool *nulls,
 										 NULL, BUFFER_LOCK_SHARE, NULL);
 			if (!lastPageTuple)
 			{
-				bool		recorded;
-
-				recorded = AutoVacuumRequestWork(AVW_BRINSummarizeRange,
-												 RelationGetRelid(idxRel),
-												 lastPageRange);
-				if (!recorded)
-					ereport(LOG,
-							(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
-							 errmsg("request for BRIN range summarization for index \"%s\" page %u was not recorded",
-									RelationGetRelationName(idxRel),
-									lastPageRange)));
+				bool		recorded = false;
+
+				if (inlinesummarize)
+					recorded = brin_summarize_inline(idxRel, heapRel,
+													 lastPageRange);
+
+				if (!recorded && autosummarize)
+				{
+					recorded = AutoVacuumRequestWork(AVW_BRINSummarizeRange,
+													 RelationGetRelid(idxRel),
+													 lastPageRange);
+					if (!recorded)
+						ereport(LOG,
+								(errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+								 errmsg("request for BRIN range summarization for index \"%s\" page %u was not recorded",
+										RelationGetRelationName(idxRel),
+										lastPageRange)));
+				}
 			}
 			else
 				LockBuffer(buf, BUFFER_LOCK_UNLOCK);
@@ -814,6 +864,7 @@ brinbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	double		idxtuples;
 	BrinRevmap *revmap;
 	BrinBuildState *state;
+	IndexBuildLeader *brinleader = NULL;
 	Buffer		meta;
 	BlockNumber pagesPerRange;
 
@@ -865,17 +916,47 @@ brinbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	state = initialize_brin_buildstate(index, revmap, pagesPerRange);
 
 	/*
-	 * Now scan the relation.  No syncscan allowed here because we want the
-	 * heap blocks in physical order.
+	 * Attempt to launch parallel workers, if requested.  Each participant
+	 * does its own time qual checks against SnapshotAny, so concurrent builds
+	 * and builds on system catalogs, which need an MVCC snapshot shared by
+	 * all participants, are always done serially.
 	 */
-	reltuples = table_index_build_scan(heap, index, indexInfo, false, true,
-									   brinbuildCallback, (void *) state, NULL);
+	if (indexInfo->ii_ParallelWorkers > 0 && !indexInfo->ii_Concurrent &&
+		!IsCatalogRelation(heap))
+		brinleader = _brin_begin_parallel(heap, index, pagesPerRange,
+										  indexInfo->ii_ParallelWorkers);
+
+	if (brinleader)
+	{
+		bool		brokenhotchain;
+
+		/* Do our share of the work, then wait for the workers */
+		_brin_parallel_build_ranges((BrinShared *) brinleader->shared, state,
+									heap, indexInfo, true);
+		reltuples = index_parallel_build_wait(brinleader, &idxtuples,
+											  &brokenhotchain);
+		if (brokenhotchain)
+			indexInfo->ii_BrokenHotChain = true;
+
+		index_parallel_build_end(brinleader);
+	}
+	else
+	{
+		/*
+		 * Now scan the relation.  No syncscan allowed here because we want
+		 * the heap blocks in physical order.
+		 */
+		reltuples = table_index_build_scan(heap, index, indexInfo, false, true,
+										   brinbuildCallback, (void *) state,
+										   NULL);
 
-	/* process the final batch */
-	form_and_insert_tuple(state);
+		/* process the final batch */
+		form_and_insert_tuple(state);
+
+		idxtuples = state->bs_numtuples;
+	}
 
 	/* release resources */
-	idxtuples = state->bs_numtuples;
 	brinRevmapTerminate(state->bs_rmAccess);
 	terminate_brin_buildstate(state);
 
@@ -970,7 +1051,8 @@ brinoptions(Datum reloptions, bool validate)
 {
 	static const relopt_parse_elt tab[] = {
 		{"pages_per_range", RELOPT_TYPE_INT, offsetof(BrinOptions, pagesPerRange)},
-		{"autosummarize", RELOPT_TYPE_BOOL, offsetof(BrinOptions, autosummarize)}
+		{"autosummarize", RELOPT_TYPE_BOOL, offsetof(BrinOptions, autosummarize)},
+		{"inline_summarize", RELOPT_TYPE_BOOL, offsetof(BrinOptions, inlineSummarize)}
 	};
 
 	return (bytea *) build_reloptions(reloptions, validate,
@@ -1559,6 +1641,33 @@ brinsummarize(Relation index, Relation heapRel, BlockNumber pageRange,
 	}
 }
 
+/*
+ * Summarize the page range containing the given heap page, if it's not
+ * summarized already, on behalf of brininsert().
+ *
+ * Summarization requires ShareUpdateExclusiveLock on the table, to keep
+ * other summarization runs out of the same range.  We only try to acquire it
+ * conditionally, so that an insertion never waits for a concurrent VACUUM or
+ * summarization; if the lock isn't available, return false and let the
+ * caller fall back to asking autovacuum to do it.
+ */
+static bool
+brin_summarize_inline(Relation index, Relation heapRel, BlockNumber pageRange)
+{
+	if (!ConditionalLockRelation(heapRel, ShareUpdateExclusiveLock))
+		return false;
+
+	brinsummarize(index, heapRel, pageRange, false, NULL, NULL);
+
+	/*
+	 * The lock only serves to serialize summarization, so there's no need to
+	 * hold it until end of transaction.
+	 */
+	UnlockRelation(heapRel, ShareUpdateExclusiveLock);
+
+	return true;
+}
+
 /*
  * Given a deformed tuple in the build state, convert it into the on-disk
  * format and insert it into the index, making the revmap point to it.
@@ -1790,3 +1899,149 @@ check_null_keys(BrinValues *bval, ScanKey *nullkeys, int nnullkeys)
 
 	return true;
 }
+
+/*
+ * Create parallel context, and launch workers for leader.
+ *
+ * There's no table scan or tuplesort to set up; participants claim chunks of
+ * the table themselves.  The caller must have initialized the index metapage
+ * already, since the workers insert summary tuples into the index directly.
+ *
+ * Returns the leader state, which caller must use to shut down parallel mode
+ * by passing it to index_parallel_build_end() at the very end of its index
+ * build.  If not even a single worker process can be launched, returns NULL,
+ * and caller should proceed with a serial index build.
+ */
+static IndexBuildLeader *
+_brin_begin_parallel(Relation heap, Relation index, BlockNumber pagesPerRange,
+					 int request)
+{
+	IndexBuildLeader *brinleader;
+	BrinShared *brinshared;
+
+	brinleader = index_parallel_build_begin("_brin_parallel_build_main",
+											heap, index, false, request,
+											sizeof(BrinShared), false, false);
+	if (brinleader == NULL)
+		return NULL;
+
+	/* Initialize our own part of the shared state */
+	brinshared = (BrinShared *) brinleader->shared;
+	brinshared->nblocks = RelationGetNumberOfBlocks(heap);
+	brinshared->chunkblocks =
+		Max(BRIN_PARALLEL_CHUNK_BLOCKS / pagesPerRange, 1) * pagesPerRange;
+	brinshared->nextblock = 0;
+
+	if (!index_parallel_build_launch(brinleader))
+		return NULL;
+
+	return brinleader;
+}
+
+/*
+ * Perform a participant's portion of a parallel build: repeatedly claim a
+ * chunk of page ranges, scan the heap blocks in it, and insert a summary
+ * tuple for each range into the index.
+ *
+ * Every range of a claimed chunk gets a summary tuple, even if it has no
+ * tuples, so that no range is left unsummarized in the middle of the table.
+ *
+ * When this returns, the participant has reported its statistics to the
+ * leader, and need only release resources.
+ */
+static void
+_brin_parallel_build_ranges(BrinShared *brinshared, BrinBuildState *state,
+							Relation heap, IndexInfo *indexInfo, bool progress)
+{
+	double		reltuples = 0;
+
+	if (progress)
+		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_TOTAL,
+									 brinshared->nblocks);
+
+	for (;;)
+	{
+		BlockNumber startblk;
+		BlockNumber endblk;
+
+		CHECK_FOR_INTERRUPTS();
+
+		/* Claim the next chunk of page ranges, if any */
+		SpinLockAcquire(&brinshared->common.mutex);
+		startblk = brinshared->nextblock;
+		if (startblk < brinshared->nblocks)
+			brinshared->nextblock += brinshared->chunkblocks;
+		SpinLockRelease(&brinshared->common.mutex);
+
+		if (startblk >= brinshared->nblocks)
+			break;
+		endblk = Min(startblk + brinshared->chunkblocks, brinshared->nblocks);
+
+		/* Report the blocks handed out so far as the scan's progress */
+		if (progress)
+			pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_DONE, startblk);
+
+		/*
+		 * Scan the chunk.  brinbuildCallback inserts the summary tuples of
+		 * the ranges it's done with as the scan moves past them.
+		 */
+		Assert(startblk % state->bs_pagesPerRange == 0);
+		state->bs_currRangeStart = startblk;
+		reltuples += table_index_build_range_scan(heap, state->bs_irel,
+												  indexInfo, false, false,
+												  false, startblk,
+												  endblk - startblk,
+												  brinbuildCallback,
+												  (void *) state, NULL);
+
+		/* Insert summary tuples for the remaining ranges of the chunk */
+		while (state->bs_currRangeStart < endblk)
+		{
+			form_and_insert_tuple(state);
+			state->bs_currRangeStart += state->bs_pagesPerRange;
+			brin_memtuple_initialize(state->bs_dtuple, state->bs_bdesc);
+		}
+	}
+
+	if (progress)
+		pgstat_progress_update_param(PROGRESS_SCAN_BLOCKS_DONE,
+									 brinshared->nblocks);
+
+	/*
+	 * Done.  Record ambuild statistics, and whether we encountered a broken
+	 * HOT chain.
+	 */
+	index_parallel_build_report(&brinshared->common, reltuples,
+								state->bs_numtuples,
+								indexInfo->ii_BrokenHotChain);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+_brin_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	BrinShared *brinshared;
+	Relation	heapRel;
+	Relation	indexRel;
+	IndexInfo  *indexInfo;
+	BrinRevmap *revmap;
+	BrinBuildState *state;
+	BlockNumber pagesPerRange;
+
+	/* We never get here for concurrent builds */
+	brinshared = (BrinShared *) index_parallel_build_attach(seg, toc,
+															&heapRel,
+															&indexRel, NULL);
+
+	/* Perform our share of the build */
+	indexInfo = BuildIndexInfo(indexRel);
+	revmap = brinRevmapInitialize(indexRel, &pagesPerRange, NULL);
+	state = initialize_brin_buildstate(indexRel, revmap, pagesPerRange);
+	_brin_parallel_build_ranges(brinshared, state, heapRel, indexInfo, false);
+	brinRevmapTerminate(revmap);
+	terminate_brin_buildstate(state);
+
+	index_parallel_build_detach(toc, &brinshared->common, heapRel, indexRel);
+}
@@ -227,6 +227,7 @@ ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
 	ginxlogUpdateMeta data;
 	bool		separateList = false;
 	bool		needCleanup = false;
+	bool		requestCleanup = false;
 	int			cleanupSize;
 	bool		needWal;
 
@@ -447,16 +448,37 @@ ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
 	 * while pending list is still small enough to fit into
 	 * gin_pending_list_limit.
 	 *
+	 * If the index has background_cleanup set, ask autovacuum to do the
+	 * cleanup instead, so that this insertion doesn't have to wait for it.
+	 * We ask again only when we've added pages to the list, which keeps
+	 * traffic on the work item queue down.  If autovacuum falls far behind,
+	 * clean up ourselves after all.  Autovacuum can't access the pages of
+	 * temporary indexes, so those are always cleaned up here.
+	 *
 	 * ginInsertCleanup() should not be called inside our CRIT_SECTION.
 	 */
 	cleanupSize = GinGetPendingListCleanupSize(index);
 	if (metadata->nPendingPages * GIN_PAGE_FREESIZE > cleanupSize * 1024L)
-		needCleanup = true;
+	{
+		if (!GinGetBackgroundCleanup(index) || !AutoVacuumingActive() ||
+			RelationUsesLocalBuffers(index) ||
+			metadata->nPendingPages * GIN_PAGE_FREESIZE >
+			GIN_BACKGROUND_CLEANUP_FACTOR * cleanupSize * 1024L)
+			needCleanup = true;
+		else if (separateList)
+			requestCleanup = true;
+	}
 
 	UnlockReleaseBuffer(metabuffer);
 
 	END_CRIT_SECTION();
 
+	/* If the work item queue is full, fall back to cleaning up ourselves */
+	if (requestCleanup &&
+		!AutoVacuumRequestWork(AVW_GINCleanPendingList,
+							   RelationGetRelid(index), InvalidBlockNumber))
+		needCleanup = true;
+
 	/*
 	 * Since it could contend with concurrent cleanup process we cleanup
 	 * pending list not forcibly.
@@ -329,13 +329,42 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		val = itemptr_to_uint64(&segment->first);
 		ptr = segment->bytes;
 		endptr = segment->bytes + segment->nbytes;
+
+		/*
+		 * Every item takes at least one byte, so make room for as many items
+		 * as there are bytes in the segment up front, rather than checking
+		 * for each item.
+		 */
+		if (ndecoded + segment->nbytes > nallocated)
+		{
+			nallocated = Max(nallocated * 2, ndecoded + segment->nbytes);
+			result = repalloc(result, nallocated * sizeof(ItemPointerData));
+		}
+
 		while (ptr < endptr)
 		{
-			/* enlarge output array if needed */
-			if (ndecoded >= nallocated)
+			/*
+			 * The deltas between items on the same heap page usually fit in
+			 * one byte each.  Check eight bytes at a time for continuation
+			 * bits, and decode a run of eight such deltas without looking at
+			 * each byte's continuation bit separately.
+			 */
+			if (endptr - ptr >= sizeof(uint64))
 			{
-				nallocated *= 2;
-				result = repalloc(result, nallocated * sizeof(ItemPointerData));
+				uint64		chunk;
+
+				memcpy(&chunk, ptr, sizeof(uint64));
+				if ((chunk & UINT64CONST(0x8080808080808080)) == 0)
+				{
+					for (int i = 0; i < sizeof(uint64); i++)
+					{
+						val += ptr[i];
+						uint64_to_itemptr(val, &result[ndecoded + i]);
+					}
+					ptr += sizeof(uint64);
+					ndecoded += sizeof(uint64);
+					continue;
+				}
 			}
 
 			val += decode_varbyte(&ptr);
@@ -14,6 +14,9 @@
  *
  * The sorted method is used if the operator classes for all columns have
  * a 'sortsupport' defined. Otherwise, we resort to the second strategy.
+ * The table scan and sort of the sorted method can be performed by parallel
+ * workers, in the same way as a parallel B-tree build (see nbtsort.c).  The
+ * leader then builds the index from the merged sort output by itself.
  *
  * The second strategy can optionally use buffers at different levels of
  * the tree to reduce I/O, see "Buffering build algorithm" in the README
@@ -37,6 +40,7 @@
 #include "access/genam.h"
 #include "access/gist_private.h"
 #include "access/gistxlog.h"
+#include "access/parallelbuild.h"
 #include "access/tableam.h"
 #include "access/xloginsert.h"
 #include "catalog/index.h"
@@ -104,6 +108,8 @@ typedef struct
 	 * Extra data structures used during a sorting build.
 	 */
 	Tuplesortstate *sortstate;	/* state data for tuplesort.c */
+	IndexBuildLeader *gistleader;	/* only present in the leader of a
+									 * parallel sorted build */
 
 	BlockNumber pages_allocated;
 	BlockNumber pages_written;
@@ -143,6 +149,15 @@ static void gist_indexsortbuild_levelstate_add(GISTBuildState *state,
 static void gist_indexsortbuild_levelstate_flush(GISTBuildState *state,
 												 GistSortedBuildLevelState *levelstate);
 static void gist_indexsortbuild_flush_ready_pages(GISTBuildState *state);
+static void gist_begin_parallel(GISTBuildState *buildstate, bool isconcurrent,
+								int request);
+static double gist_parallel_heapscan(GISTBuildState *buildstate,
+									 bool *brokenhotchain);
+static void gist_leader_participate_as_worker(GISTBuildState *buildstate);
+static void gist_parallel_scan_and_sort(IndexBuildShared *gistshared,
+										Sharedsort *sharedsort,
+										Relation heap, Relation index,
+										int sortmem, bool progress);
 
 static void gistInitBuffering(GISTBuildState *buildstate);
 static int	calculatePagesPerBuffer(GISTBuildState *buildstate, int levelStep);
@@ -200,6 +215,7 @@ gistbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	buildstate.indexrel = index;
 	buildstate.heaprel = heap;
 	buildstate.sortstate = NULL;
+	buildstate.gistleader = NULL;
 	buildstate.giststate = initGISTstate(index);
 
 	/*
@@ -264,19 +280,38 @@ gistbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 
 	if (buildstate.buildMode == GIST_SORTED_BUILD)
 	{
+		SortCoordinate coordinate = NULL;
+
+		/* Attempt to launch parallel workers to scan and sort, if requested */
+		if (indexInfo->ii_ParallelWorkers > 0)
+			gist_begin_parallel(&buildstate, indexInfo->ii_Concurrent,
+								indexInfo->ii_ParallelWorkers);
+
+		if (buildstate.gistleader)
+		{
+			coordinate = (SortCoordinate) palloc0(sizeof(SortCoordinateData));
+			coordinate->isWorker = false;
+			coordinate->nParticipants = buildstate.gistleader->nparticipants;
+			coordinate->sharedsort = buildstate.gistleader->sharedsort;
+		}
+
 		/*
 		 * Sort all data, build the index from bottom up.
 		 */
 		buildstate.sortstate = tuplesort_begin_index_gist(heap,
 														  index,
 														  maintenance_work_mem,
-														  NULL,
+														  coordinate,
 														  TUPLESORT_NONE);
 
 		/* Scan the table, adding all tuples to the tuplesort */
-		reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
-										   gistSortedBuildCallback,
-										   (void *) &buildstate, NULL);
+		if (!buildstate.gistleader)
+			reltuples = table_index_build_scan(heap, index, indexInfo, true, true,
+											   gistSortedBuildCallback,
+											   (void *) &buildstate, NULL);
+		else
+			reltuples = gist_parallel_heapscan(&buildstate,
+											   &indexInfo->ii_BrokenHotChain);
 
 		/*
 		 * Perform the sort and build index pages.
@@ -286,6 +321,9 @@ gistbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 		gist_indexsortbuild(&buildstate);
 
 		tuplesort_end(buildstate.sortstate);
+
+		if (buildstate.gistleader)
+			index_parallel_build_end(buildstate.gistleader);
 	}
 	else
 	{
@@ -673,6 +711,182 @@ gist_indexsortbuild_flush_ready_pages(GISTBuildState *state)
 }
 
 
+/*-------------------------------------------------------------------------
+ * Routines for parallel sorted build
+ *-------------------------------------------------------------------------
+ */
+
+/*
+ * Create parallel context, and launch workers for leader.
+ *
+ * Each participant scans a part of the table and performs its own partial
+ * sort; the leader merges the results in its own tuplesort, and builds the
+ * index pages by itself.
+ *
+ * Sets buildstate's gistleader, which caller must use to shut down parallel
+ * mode by passing it to index_parallel_build_end() at the very end of its
+ * index build.  If not even a single worker process can be launched, this is
+ * never set, and caller should proceed with a serial index build.
+ */
+static void
+gist_begin_parallel(GISTBuildState *buildstate, bool isconcurrent, int request)
+{
+	IndexBuildLeader *gistleader;
+
+	gistleader = index_parallel_build_begin("gist_parallel_build_main",
+											buildstate->heaprel,
+											buildstate->indexrel,
+											isconcurrent, request,
+											sizeof(IndexBuildShared),
+											true, true);
+
+	/* If no DSM segment or no worker was available, do serial build */
+	if (gistleader == NULL || !index_parallel_build_launch(gistleader))
+		return;
+
+	/* Save leader state now that it's clear build will be parallel */
+	buildstate->gistleader = gistleader;
+
+	/* Join heap scan ourselves */
+	gist_leader_participate_as_worker(buildstate);
+}
+
+/*
+ * Within leader, wait for end of heap scan.
+ *
+ * Fills in the number of index tuples in buildstate, and lets caller set
+ * field indicating that some worker encountered a broken HOT chain.
+ *
+ * Returns the total number of heap tuples scanned.
+ */
+static double
+gist_parallel_heapscan(GISTBuildState *buildstate, bool *brokenhotchain)
+{
+	double		indtuples;
+	double		reltuples;
+
+	reltuples = index_parallel_build_wait(buildstate->gistleader, &indtuples,
+										  brokenhotchain);
+	buildstate->indtuples = (int64) indtuples;
+
+	return reltuples;
+}
+
+/*
+ * Within leader, participate as a parallel worker.
+ */
+static void
+gist_leader_participate_as_worker(GISTBuildState *buildstate)
+{
+	IndexBuildLeader *gistleader = buildstate->gistleader;
+	int			sortmem;
+
+	/*
+	 * Might as well use reliable figure when doling out maintenance_work_mem
+	 * (when requested number of workers were not launched, this will be
+	 * somewhat higher than it is for other workers).
+	 */
+	sortmem = maintenance_work_mem / gistleader->nparticipants;
+
+	/* Perform work common to all participants */
+	gist_parallel_scan_and_sort(gistleader->shared,
+								gistleader->sharedsort,
+								buildstate->heaprel, buildstate->indexrel,
+								sortmem, true);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+gist_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	IndexBuildShared *gistshared;
+	Sharedsort *sharedsort;
+	Relation	heapRel;
+	Relation	indexRel;
+	int			sortmem;
+
+	gistshared = index_parallel_build_attach(seg, toc, &heapRel, &indexRel,
+											 &sharedsort);
+
+	/* Perform our share of the scan and sort */
+	sortmem = maintenance_work_mem / gistshared->scantuplesortstates;
+	gist_parallel_scan_and_sort(gistshared, sharedsort, heapRel, indexRel,
+								sortmem, false);
+
+	index_parallel_build_detach(toc, gistshared, heapRel, indexRel);
+}
+
+/*
+ * Perform a participant's portion of a parallel sort: scan its share of the
+ * table, feeding a "partial" tuplesort, and sort that.
+ *
+ * sortmem is the amount of working memory to use within each participant,
+ * expressed in KBs.
+ *
+ * When this returns, the participant is done, and need only release
+ * resources.
+ */
+static void
+gist_parallel_scan_and_sort(IndexBuildShared *gistshared,
+							Sharedsort *sharedsort,
+							Relation heap, Relation index,
+							int sortmem, bool progress)
+{
+	SortCoordinate coordinate;
+	GISTBuildState buildstate;
+	TableScanDesc scan;
+	double		reltuples;
+	IndexInfo  *indexInfo;
+
+	/* Initialize local tuplesort coordination state */
+	coordinate = palloc0(sizeof(SortCoordinateData));
+	coordinate->isWorker = true;
+	coordinate->nParticipants = -1;
+	coordinate->sharedsort = sharedsort;
+
+	/* Fill in the parts of buildstate used by gistSortedBuildCallback() */
+	memset(&buildstate, 0, sizeof(buildstate));
+	buildstate.indexrel = index;
+	buildstate.heaprel = heap;
+	buildstate.giststate = initGISTstate(index);
+	buildstate.giststate->tempCxt = createTempGistContext();
+	buildstate.buildMode = GIST_SORTED_BUILD;
+	buildstate.indtuples = 0;
+
+	/* Begin "partial" tuplesort */
+	buildstate.sortstate = tuplesort_begin_index_gist(heap, index, sortmem,
+													  coordinate,
+													  TUPLESORT_NONE);
+
+	/* Join parallel scan */
+	indexInfo = BuildIndexInfo(index);
+	indexInfo->ii_Concurrent = gistshared->isconcurrent;
+	scan = table_beginscan_parallel(heap,
+									ParallelTableScanFromIndexBuildShared(gistshared));
+	reltuples = table_index_build_scan(heap, index, indexInfo, true, progress,
+									   gistSortedBuildCallback,
+									   (void *) &buildstate, scan);
+
+	/* Execute this participant's part of the sort */
+	tuplesort_performsort(buildstate.sortstate);
+
+	/*
+	 * Done.  Record ambuild statistics, and whether we encountered a broken
+	 * HOT chain.
+	 */
+	index_parallel_build_report(gistshared, reltuples, buildstate.indtuples,
+								indexInfo->ii_BrokenHotChain);
+
+	/* We can end tuplesorts immediately */
+	tuplesort_end(buildstate.sortstate);
+
+	MemoryContextDelete(buildstate.giststate->tempCxt);
+	freeGISTstate(buildstate.giststate);
+}
+
+
 /*-------------------------------------------------------------------------
  * Routines for non-sorted build
  *-------------------------------------------------------------------------
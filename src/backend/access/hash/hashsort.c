@@ -13,6 +13,10 @@
  * hash code value.  That's no big problem though, since we'll still have
  * plenty of locality of access.
  *
+ * The table scan and the sort can be performed by parallel workers, in the
+ * same way as a parallel B-tree build (see nbtsort.c).  The leader merges
+ * the workers' sorted runs and inserts the tuples into the index by itself.
+ *
  *
  * Portions Copyright (c) 1996-2022, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -26,12 +30,30 @@
 #include "postgres.h"
 
 #include "access/hash.h"
+#include "access/parallelbuild.h"
+#include "access/tableam.h"
+#include "catalog/index.h"
 #include "commands/progress.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/pg_bitutils.h"
+#include "utils/rel.h"
 #include "utils/tuplesort.h"
 
+/*
+ * Status for index builds performed in parallel.  This is allocated in a
+ * dynamic shared memory segment, followed by the parallel table scan
+ * descriptor.
+ */
+typedef struct HashShared
+{
+	IndexBuildShared common;	/* must be first */
+
+	/* Bucket masks that the participants' sorts are based on */
+	uint32		high_mask;
+	uint32		low_mask;
+	uint32		max_buckets;
+} HashShared;
 
 /*
  * Status record for spooling/sorting phase.
@@ -40,6 +62,10 @@ struct HSpool
 {
 	Tuplesortstate *sortstate;	/* state data for tuplesort.c */
 	Relation	index;
+	Relation	heap;
+	IndexBuildLeader *hashleader;	/* only present in the leader of a
+									 * parallel build */
+	double		indtuples;		/* # tuples spooled by this participant */
 
 	/*
 	 * We sort the hash keys based on the buckets they belong to. Below masks
@@ -51,16 +77,32 @@ struct HSpool
 	uint32		max_buckets;
 };
 
+static void _h_spool_callback(Relation index, ItemPointer tid, Datum *values,
+							  bool *isnull, bool tupleIsAlive, void *state);
+static void _h_begin_parallel(HSpool *hspool, bool isconcurrent, int request);
+static void _h_parallel_scan_and_sort(HashShared *hashshared,
+									  Sharedsort *sharedsort,
+									  Relation heap, Relation index,
+									  int sortmem, bool progress);
+
 
 /*
  * create and initialize a spool structure
+ *
+ * If request is greater than zero, attempt to launch that many parallel
+ * workers to scan the table and sort the tuples along with the leader; the
+ * caller should then use _h_parallel_heapscan() rather than scanning the
+ * table itself, if _h_spool_is_parallel() says the workers were launched.
  */
 HSpool *
-_h_spoolinit(Relation heap, Relation index, uint32 num_buckets)
+_h_spoolinit(Relation heap, Relation index, uint32 num_buckets,
+			 bool isconcurrent, int request)
 {
 	HSpool	   *hspool = (HSpool *) palloc0(sizeof(HSpool));
+	SortCoordinate coordinate = NULL;
 
 	hspool->index = index;
+	hspool->heap = heap;
 
 	/*
 	 * Determine the bitmask for hash code values.  Since there are currently
@@ -74,10 +116,23 @@ _h_spoolinit(Relation heap, Relation index, uint32 num_buckets)
 	hspool->low_mask = (hspool->high_mask >> 1);
 	hspool->max_buckets = num_buckets - 1;
 
+	/* Attempt to launch parallel workers to scan and sort, if requested */
+	if (request > 0)
+		_h_begin_parallel(hspool, isconcurrent, request);
+
+	if (hspool->hashleader)
+	{
+		coordinate = (SortCoordinate) palloc0(sizeof(SortCoordinateData));
+		coordinate->isWorker = false;
+		coordinate->nParticipants = hspool->hashleader->nparticipants;
+		coordinate->sharedsort = hspool->hashleader->sharedsort;
+	}
+
 	/*
 	 * We size the sort area as maintenance_work_mem rather than work_mem to
 	 * speed index creation.  This should be OK since a single backend can't
-	 * run multiple index creations in parallel.
+	 * run multiple index creations in parallel.  (In a parallel build, this
+	 * is only the leader's final merge.)
 	 */
 	hspool->sortstate = tuplesort_begin_index_hash(heap,
 												   index,
@@ -85,7 +140,7 @@ _h_spoolinit(Relation heap, Relation index, uint32 num_buckets)
 												   hspool->low_mask,
 												   hspool->max_buckets,
 												   maintenance_work_mem,
-												   NULL,
+												   coordinate,
 												   TUPLESORT_NONE);
 
 	return hspool;
@@ -98,9 +153,20 @@ void
 _h_spooldestroy(HSpool *hspool)
 {
 	tuplesort_end(hspool->sortstate);
+	if (hspool->hashleader)
+		index_parallel_build_end(hspool->hashleader);
 	pfree(hspool);
 }
 
+/*
+ * Are parallel workers scanning the table for this spool?
+ */
+bool
+_h_spool_is_parallel(HSpool *hspool)
+{
+	return hspool->hashleader != NULL;
+}
+
 /*
  * spool an index entry into the sort file.
  */
@@ -150,3 +216,191 @@ _h_indexbuild(HSpool *hspool, Relation heapRel)
 									 ++tups_done);
 	}
 }
+
+/*
+ * Per-tuple callback for table_index_build_scan, used by the participants
+ * of a parallel build.  This is the spooling half of hashbuildCallback().
+ */
+static void
+_h_spool_callback(Relation index,
+				  ItemPointer tid,
+				  Datum *values,
+				  bool *isnull,
+				  bool tupleIsAlive,
+				  void *state)
+{
+	HSpool	   *hspool = (HSpool *) state;
+	Datum		index_values[1];
+	bool		index_isnull[1];
+
+	/* convert data to a hash key; on failure, do not insert anything */
+	if (!_hash_convert_tuple(index,
+							 values, isnull,
+							 index_values, index_isnull))
+		return;
+
+	_h_spool(hspool, tid, index_values, index_isnull);
+
+	hspool->indtuples += 1;
+}
+
+/*
+ * Create parallel context, and launch workers for leader.
+ *
+ * Each participant scans a part of the table and performs its own partial
+ * sort; the leader merges the results in its own tuplesort, and inserts the
+ * tuples by itself.
+ *
+ * Sets hspool's hashleader, which is used to shut down parallel mode in
+ * _h_spooldestroy().  If not even a single worker process can be launched,
+ * this is never set, and caller should proceed with a serial index build.
+ */
+static void
+_h_begin_parallel(HSpool *hspool, bool isconcurrent, int request)
+{
+	IndexBuildLeader *hashleader;
+	HashShared *hashshared;
+
+	hashleader = index_parallel_build_begin("_h_parallel_build_main",
+											hspool->heap, hspool->index,
+											isconcurrent, request,
+											sizeof(HashShared), true, true);
+	if (hashleader == NULL)
+		return;
+
+	/* Initialize our own part of the shared state */
+	hashshared = (HashShared *) hashleader->shared;
+	hashshared->high_mask = hspool->high_mask;
+	hashshared->low_mask = hspool->low_mask;
+	hashshared->max_buckets = hspool->max_buckets;
+
+	/* If no workers were launched, hashleader is gone; do serial build */
+	if (!index_parallel_build_launch(hashleader))
+		return;
+
+	/* Save leader state now that it's clear build will be parallel */
+	hspool->hashleader = hashleader;
+}
+
+/*
+ * Within leader, participate as a parallel worker, then wait for the end of
+ * the heap scan.
+ *
+ * Sets *indtuples to the number of tuples spooled by all participants, and
+ * lets caller set field indicating that some worker encountered a broken HOT
+ * chain.
+ *
+ * Returns the total number of heap tuples scanned.
+ */
+double
+_h_parallel_heapscan(HSpool *hspool, bool *brokenhotchain, double *indtuples)
+{
+	IndexBuildLeader *hashleader = hspool->hashleader;
+	int			sortmem;
+
+	Assert(hashleader != NULL);
+
+	/*
+	 * Might as well use reliable figure when doling out maintenance_work_mem
+	 * (when requested number of workers were not launched, this will be
+	 * somewhat higher than it is for other workers).
+	 */
+	sortmem = maintenance_work_mem / hashleader->nparticipants;
+
+	/* Perform work common to all participants */
+	_h_parallel_scan_and_sort((HashShared *) hashleader->shared,
+							  hashleader->sharedsort,
+							  hspool->heap, hspool->index, sortmem, true);
+
+	return index_parallel_build_wait(hashleader, indtuples, brokenhotchain);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+_h_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	HashShared *hashshared;
+	Sharedsort *sharedsort;
+	Relation	heapRel;
+	Relation	indexRel;
+	int			sortmem;
+
+	hashshared = (HashShared *) index_parallel_build_attach(seg, toc,
+															&heapRel,
+															&indexRel,
+															&sharedsort);
+
+	/* Perform our share of the scan and sort */
+	sortmem = maintenance_work_mem / hashshared->common.scantuplesortstates;
+	_h_parallel_scan_and_sort(hashshared, sharedsort, heapRel, indexRel,
+							  sortmem, false);
+
+	index_parallel_build_detach(toc, &hashshared->common, heapRel, indexRel);
+}
+
+/*
+ * Perform a participant's portion of a parallel sort: scan its share of the
+ * table, feeding a "partial" tuplesort, and sort that.
+ *
+ * sortmem is the amount of working memory to use within each participant,
+ * expressed in KBs.
+ *
+ * When this returns, the participant is done, and need only release
+ * resources.
+ */
+static void
+_h_parallel_scan_and_sort(HashShared *hashshared, Sharedsort *sharedsort,
+						  Relation heap, Relation index,
+						  int sortmem, bool progress)
+{
+	SortCoordinate coordinate;
+	HSpool		hspool;
+	TableScanDesc scan;
+	double		reltuples;
+	IndexInfo  *indexInfo;
+
+	/* Initialize local tuplesort coordination state */
+	coordinate = palloc0(sizeof(SortCoordinateData));
+	coordinate->isWorker = true;
+	coordinate->nParticipants = -1;
+	coordinate->sharedsort = sharedsort;
+
+	/* Begin "partial" tuplesort */
+	memset(&hspool, 0, sizeof(hspool));
+	hspool.index = index;
+	hspool.heap = heap;
+	hspool.high_mask = hashshared->high_mask;
+	hspool.low_mask = hashshared->low_mask;
+	hspool.max_buckets = hashshared->max_buckets;
+	hspool.sortstate = tuplesort_begin_index_hash(heap, index,
+												  hspool.high_mask,
+												  hspool.low_mask,
+												  hspool.max_buckets,
+												  sortmem, coordinate,
+												  TUPLESORT_NONE);
+
+	/* Join parallel scan */
+	indexInfo = BuildIndexInfo(index);
+	indexInfo->ii_Concurrent = hashshared->common.isconcurrent;
+	scan = table_beginscan_parallel(heap,
+									ParallelTableScanFromIndexBuildShared(&hashshared->common));
+	reltuples = table_index_build_scan(heap, index, indexInfo, true, progress,
+									   _h_spool_callback, (void *) &hspool,
+									   scan);
+
+	/* Execute this participant's part of the sort */
+	tuplesort_performsort(hspool.sortstate);
+
+	/*
+	 * Done.  Record ambuild statistics, and whether we encountered a broken
+	 * HOT chain.
+	 */
+	index_parallel_build_report(&hashshared->common, reltuples,
+								hspool.indtuples,
+								indexInfo->ii_BrokenHotChain);
+
+	/* We can end tuplesorts immediately */
+	tuplesort_end(hspool.sortstate);
+}
@@ -18,6 +18,7 @@
 #include "access/heapam_xlog.h"
 #include "access/htup_details.h"
 #include "access/transam.h"
+#include "access/visibilitymap.h"
 #include "access/xlog.h"
 #include "access/xloginsert.h"
 #include "catalog/catalog.h"
@@ -90,6 +91,9 @@ static void heap_prune_record_redirect(PruneState *prstate,
 static void heap_prune_record_dead(PruneState *prstate, OffsetNumber offnum);
 static void heap_prune_record_unused(PruneState *prstate, OffsetNumber offnum);
 static void page_verify_redirects(Page page);
+static void heap_page_prune_set_all_visible(Relation relation, Buffer buffer,
+											Buffer vmbuffer,
+											GlobalVisState *vistest);
 
 
 /*
@@ -191,9 +195,26 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 
 	if (PageIsFull(page) || PageGetHeapFreeSpace(page) < minfree)
 	{
+		Buffer		vmbuffer = InvalidBuffer;
+
+		/*
+		 * If the page isn't already all-visible, pruning might make it so, in
+		 * which case we'll want to set its visibility map bit, so that
+		 * index-only scans don't have to visit the page until it's modified
+		 * again.  Pin the visibility map page now, since that might require
+		 * I/O, which we don't want to do while holding the buffer lock.
+		 */
+		if (!PageIsAllVisible(page))
+			visibilitymap_pin(relation, BufferGetBlockNumber(buffer),
+							  &vmbuffer);
+
 		/* OK, try to get exclusive buffer lock */
 		if (!ConditionalLockBufferForCleanup(buffer))
+		{
+			if (BufferIsValid(vmbuffer))
+				ReleaseBuffer(vmbuffer);
 			return;
+		}
 
 		/*
 		 * Now that we have buffer lock, get accurate information about the
@@ -226,11 +247,18 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 			if (ndeleted > nnewlpdead)
 				pgstat_update_heap_dead_tuples(relation,
 											   ndeleted - nnewlpdead);
+
+			if (BufferIsValid(vmbuffer) && !PageIsAllVisible(page))
+				heap_page_prune_set_all_visible(relation, buffer, vmbuffer,
+												vistest);
 		}
 
 		/* And release buffer lock */
 		LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
 
+		if (BufferIsValid(vmbuffer))
+			ReleaseBuffer(vmbuffer);
+
 		/*
 		 * We avoid reuse of any free space created on the page by unrelated
 		 * UPDATEs/INSERTs by opting to not update the FSM at this point.  The
@@ -240,6 +268,99 @@ heap_page_prune_opt(Relation relation, Buffer buffer)
 }
 
 
+/*
+ * Set the all-visible bit of a just-pruned page, if every tuple remaining on
+ * it is visible to everyone according to vistest.
+ *
+ * This lets opportunistic pruning keep the visibility map up to date for
+ * pages that are modified and read frequently, instead of waiting for the
+ * next VACUUM to do it.  Index-only scans on such tables would otherwise
+ * have to visit the heap for every tuple on those pages.
+ *
+ * This is a simplified version of the checks VACUUM does in
+ * lazy_scan_prune() and heap_page_is_all_visible(): we never set the
+ * all-frozen bit, and we give up as soon as we see anything that isn't
+ * visible to everyone, including LP_DEAD items left behind by pruning.
+ *
+ * Caller must hold a buffer cleanup lock on the heap page, and a pin on the
+ * visibility map page covering it.
+ */
+static void
+heap_page_prune_set_all_visible(Relation relation, Buffer buffer,
+								Buffer vmbuffer, GlobalVisState *vistest)
+{
+	Page		page = BufferGetPage(buffer);
+	BlockNumber blockno = BufferGetBlockNumber(buffer);
+	OffsetNumber offnum,
+				maxoff;
+	TransactionId visibility_cutoff_xid = InvalidTransactionId;
+	HeapTupleData tup;
+
+	tup.t_tableOid = RelationGetRelid(relation);
+
+	maxoff = PageGetMaxOffsetNumber(page);
+	for (offnum = FirstOffsetNumber;
+		 offnum <= maxoff;
+		 offnum = OffsetNumberNext(offnum))
+	{
+		ItemId		itemid = PageGetItemId(page, offnum);
+		TransactionId dead_after;
+		TransactionId xmin;
+
+		/* Unused or redirect line pointers are of no interest */
+		if (!ItemIdIsUsed(itemid) || ItemIdIsRedirected(itemid))
+			continue;
+
+		/*
+		 * Dead line pointers can have index pointers pointing to them, so
+		 * they can't be treated as visible.
+		 */
+		if (ItemIdIsDead(itemid))
+			return;
+
+		Assert(ItemIdIsNormal(itemid));
+
+		tup.t_data = (HeapTupleHeader) PageGetItem(page, itemid);
+		tup.t_len = ItemIdGetLength(itemid);
+		ItemPointerSet(&(tup.t_self), blockno, offnum);
+
+		if (HeapTupleSatisfiesVacuumHorizon(&tup, buffer, &dead_after) !=
+			HEAPTUPLE_LIVE)
+			return;
+
+		/* See comments in lazy_scan_prune() */
+		if (!HeapTupleHeaderXminCommitted(tup.t_data))
+			return;
+
+		/*
+		 * The inserter definitely committed.  But is it old enough that
+		 * everyone sees it as committed?
+		 */
+		xmin = HeapTupleHeaderGetXmin(tup.t_data);
+		if (TransactionIdIsNormal(xmin))
+		{
+			if (!GlobalVisTestIsRemovableXid(vistest, xmin))
+				return;
+
+			/* Track newest xmin on page. */
+			if (TransactionIdFollows(xmin, visibility_cutoff_xid))
+				visibility_cutoff_xid = xmin;
+		}
+	}
+
+	/*
+	 * Set both the page-level bit and the visibility map bit.  As in VACUUM,
+	 * the heap page must be marked dirty before calling visibilitymap_set(),
+	 * since it may be WAL-logged if checksums are enabled.
+	 */
+	PageSetAllVisible(page);
+	MarkBufferDirty(buffer);
+	visibilitymap_set(relation, blockno, buffer, InvalidXLogRecPtr,
+					  vmbuffer, visibility_cutoff_xid,
+					  VISIBILITYMAP_ALL_VISIBLE);
+}
+
+
 /*
  * Prune and repair fragmentation in the specified page.
  *
@@ -0,0 +1,441 @@
+/*-------------------------------------------------------------------------
+ *
+ * parallelbuild.c
+ *	  Infrastructure shared by parallel index builds.
+ *
+ * A parallel index build has the leader and each worker process take a
+ * share of the work, such as scanning part of the table and sorting it, and
+ * report their statistics back to the leader through a shared struct.  The
+ * routines here take care of what is the same for every access method:
+ * setting up the parallel context and the shared struct, passing the query
+ * text and accumulating WAL and buffer usage of the workers, opening the
+ * relations in the workers, and waiting for all participants to finish.
+ * nbtsort.c predates this, and has its own copy of this logic.
+ *
+ * The leader calls index_parallel_build_begin(), fills in the access
+ * method's own part of the shared struct, and calls
+ * index_parallel_build_launch().  Each participant, including the leader,
+ * does its share of the work and calls index_parallel_build_report() at
+ * the end.  The leader then waits for the others with
+ * index_parallel_build_wait(), and shuts down parallel mode with
+ * index_parallel_build_end() at the very end of its index build.
+ *
+ * The worker entry point of an access method must call
+ * index_parallel_build_attach() first, and index_parallel_build_detach()
+ * when it's done.
+ *
+ *
+ * Portions Copyright (c) 1996-2022, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/index/parallelbuild.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/genam.h"
+#include "access/parallelbuild.h"
+#include "access/table.h"
+#include "access/tableam.h"
+#include "access/xact.h"
+#include "catalog/index.h"
+#include "pgstat.h"
+#include "storage/proc.h"
+#include "tcop/tcopprot.h"		/* pgrminclude ignore */
+#include "utils/snapmgr.h"
+#include "utils/tuplesort.h"
+
+/* Magic numbers for parallel state sharing */
+#define PARALLEL_KEY_INDEX_BUILD_SHARED	UINT64CONST(0xA100000000000001)
+#define PARALLEL_KEY_TUPLESORT			UINT64CONST(0xA100000000000002)
+#define PARALLEL_KEY_QUERY_TEXT			UINT64CONST(0xA100000000000003)
+#define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xA100000000000004)
+#define PARALLEL_KEY_BUFFER_USAGE		UINT64CONST(0xA100000000000005)
+
+/*
+ * Create parallel context for a parallel index build, and set up its
+ * shared state.
+ *
+ * function_name is the name of the access method's worker entry point, which
+ * must be listed in parallel.c.  request is the target number of parallel
+ * worker processes to launch.  sharedsize is the size of the access method's
+ * shared struct, which starts with an IndexBuildShared.  If scan is true,
+ * a parallel table scan is set up for the participants to join; it uses an
+ * MVCC snapshot for CREATE INDEX CONCURRENTLY (isconcurrent), and
+ * SnapshotAny otherwise.  If sort is true, shared tuplesort state is set up
+ * for one partial sort per participant.
+ *
+ * Returns NULL if no DSM segment was available; the caller should then
+ * proceed with a serial index build.  Otherwise the caller should fill in
+ * its own part of leader->shared, and launch the workers with
+ * index_parallel_build_launch().
+ */
+IndexBuildLeader *
+index_parallel_build_begin(const char *function_name, Relation heap,
+						   Relation index, bool isconcurrent, int request,
+						   Size sharedsize, bool scan, bool sort)
+{
+	ParallelContext *pcxt;
+	int			scantuplesortstates;
+	Snapshot	snapshot = InvalidSnapshot;
+	Size		estshared;
+	Size		estsort = 0;
+	IndexBuildShared *shared;
+	Sharedsort *sharedsort = NULL;
+	IndexBuildLeader *leader;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+	int			querylen;
+
+	Assert(sharedsize >= sizeof(IndexBuildShared));
+
+	/*
+	 * Enter parallel mode, and create context for parallel build of the
+	 * index
+	 */
+	EnterParallelMode();
+	Assert(request > 0);
+	pcxt = CreateParallelContext("postgres", function_name, request);
+
+	/* The leader always participates as a worker */
+	scantuplesortstates = request + 1;
+
+	/*
+	 * Prepare for scan of the base relation.  In a normal index build, we use
+	 * SnapshotAny because we must retrieve all tuples and do our own time
+	 * qual checks (because we have to index RECENTLY_DEAD tuples).  In a
+	 * concurrent build, we take a regular MVCC snapshot and index whatever's
+	 * live according to that.
+	 */
+	if (scan)
+	{
+		if (!isconcurrent)
+			snapshot = SnapshotAny;
+		else
+			snapshot = RegisterSnapshot(GetTransactionSnapshot());
+	}
+
+	/*
+	 * Estimate size for the shared workspace, including the parallel table
+	 * scan that follows it (c.f. shm_toc_allocate as to why BUFFERALIGN is
+	 * used), and for the tuplesort workspace
+	 */
+	estshared = BUFFERALIGN(sharedsize);
+	if (scan)
+		estshared = add_size(estshared,
+							 table_parallelscan_estimate(heap, snapshot));
+	shm_toc_estimate_chunk(&pcxt->estimator, estshared);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	if (sort)
+	{
+		estsort = tuplesort_estimate_shared(scantuplesortstates);
+		shm_toc_estimate_chunk(&pcxt->estimator, estsort);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
+
+	/* Estimate space for WalUsage and BufferUsage */
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/* Finally, estimate PARALLEL_KEY_QUERY_TEXT space */
+	if (debug_query_string)
+	{
+		querylen = strlen(debug_query_string);
+		shm_toc_estimate_chunk(&pcxt->estimator, querylen + 1);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
+	else
+		querylen = 0;			/* keep compiler quiet */
+
+	/* Everyone's had a chance to ask for space, so now create the DSM */
+	InitializeParallelDSM(pcxt);
+
+	/* If no DSM segment was available, back out (do serial build) */
+	if (pcxt->seg == NULL)
+	{
+		if (snapshot != InvalidSnapshot && IsMVCCSnapshot(snapshot))
+			UnregisterSnapshot(snapshot);
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return NULL;
+	}
+
+	/* Store shared build state, for which we reserved space */
+	shared = (IndexBuildShared *) shm_toc_allocate(pcxt->toc, estshared);
+	memset(shared, 0, sharedsize);
+	/* Initialize immutable state */
+	shared->heaprelid = RelationGetRelid(heap);
+	shared->indexrelid = RelationGetRelid(index);
+	shared->isconcurrent = isconcurrent;
+	shared->scantuplesortstates = scantuplesortstates;
+	shared->scanoffset = scan ? BUFFERALIGN(sharedsize) : 0;
+	ConditionVariableInit(&shared->workersdonecv);
+	SpinLockInit(&shared->mutex);
+	/* Initialize mutable state */
+	shared->nparticipantsdone = 0;
+	shared->reltuples = 0.0;
+	shared->indtuples = 0.0;
+	shared->brokenhotchain = false;
+	if (scan)
+		table_parallelscan_initialize(heap,
+									  ParallelTableScanFromIndexBuildShared(shared),
+									  snapshot);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_INDEX_BUILD_SHARED, shared);
+
+	/*
+	 * Store shared tuplesort-private state, for which we reserved space.
+	 * Then, initialize opaque state using tuplesort routine.
+	 */
+	if (sort)
+	{
+		sharedsort = (Sharedsort *) shm_toc_allocate(pcxt->toc, estsort);
+		tuplesort_initialize_shared(sharedsort, scantuplesortstates,
+									pcxt->seg);
+		shm_toc_insert(pcxt->toc, PARALLEL_KEY_TUPLESORT, sharedsort);
+	}
+
+	/* Store query string for workers */
+	if (debug_query_string)
+	{
+		char	   *sharedquery;
+
+		sharedquery = (char *) shm_toc_allocate(pcxt->toc, querylen + 1);
+		memcpy(sharedquery, debug_query_string, querylen + 1);
+		shm_toc_insert(pcxt->toc, PARALLEL_KEY_QUERY_TEXT, sharedquery);
+	}
+
+	/*
+	 * Allocate space for each worker's WalUsage and BufferUsage; no need to
+	 * initialize.
+	 */
+	walusage = shm_toc_allocate(pcxt->toc,
+								mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_WAL_USAGE, walusage);
+	bufferusage = shm_toc_allocate(pcxt->toc,
+								   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_BUFFER_USAGE, bufferusage);
+
+	leader = (IndexBuildLeader *) palloc0(sizeof(IndexBuildLeader));
+	leader->pcxt = pcxt;
+	leader->shared = shared;
+	leader->sharedsort = sharedsort;
+	leader->snapshot = snapshot;
+	leader->walusage = walusage;
+	leader->bufferusage = bufferusage;
+
+	return leader;
+}
+
+/*
+ * Launch workers for leader.
+ *
+ * Returns true if at least one worker was launched.  Otherwise, shuts down
+ * parallel mode and frees leader, and returns false; the caller should then
+ * proceed with a serial index build.
+ */
+bool
+index_parallel_build_launch(IndexBuildLeader *leader)
+{
+	ParallelContext *pcxt = leader->pcxt;
+
+	LaunchParallelWorkers(pcxt);
+	leader->nparticipants = pcxt->nworkers_launched + 1;
+
+	/* If no workers were successfully launched, back out (do serial build) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		index_parallel_build_end(leader);
+		return false;
+	}
+
+	/*
+	 * Caller needs to wait for all launched workers when we return.  Make
+	 * sure that the failure-to-start case will not hang forever.
+	 */
+	WaitForParallelWorkersToAttach(pcxt);
+
+	return true;
+}
+
+/*
+ * Within leader, wait for all participants, including the leader itself, to
+ * report the end of their share of the build.
+ *
+ * Returns the total number of heap tuples scanned, and sets *indtuples to
+ * the number of index tuples reported by all participants, and
+ * *brokenhotchain if any participant encountered a broken HOT chain.
+ */
+double
+index_parallel_build_wait(IndexBuildLeader *leader, double *indtuples,
+						  bool *brokenhotchain)
+{
+	IndexBuildShared *shared = leader->shared;
+	double		reltuples;
+
+	for (;;)
+	{
+		SpinLockAcquire(&shared->mutex);
+		if (shared->nparticipantsdone == leader->nparticipants)
+		{
+			reltuples = shared->reltuples;
+			*indtuples = shared->indtuples;
+			*brokenhotchain = shared->brokenhotchain;
+			SpinLockRelease(&shared->mutex);
+			break;
+		}
+		SpinLockRelease(&shared->mutex);
+
+		ConditionVariableSleep(&shared->workersdonecv,
+							   WAIT_EVENT_PARALLEL_CREATE_INDEX_SCAN);
+	}
+
+	ConditionVariableCancelSleep();
+
+	return reltuples;
+}
+
+/*
+ * Shut down workers, destroy parallel context, and end parallel mode.
+ */
+void
+index_parallel_build_end(IndexBuildLeader *leader)
+{
+	/* Shutdown worker processes */
+	WaitForParallelWorkersToFinish(leader->pcxt);
+
+	/*
+	 * Next, accumulate WAL usage.  (This must wait for the workers to finish,
+	 * or we might get incomplete data.)
+	 */
+	for (int i = 0; i < leader->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&leader->bufferusage[i],
+								&leader->walusage[i]);
+
+	/* Free last reference to MVCC snapshot, if one was used */
+	if (leader->snapshot != InvalidSnapshot &&
+		IsMVCCSnapshot(leader->snapshot))
+		UnregisterSnapshot(leader->snapshot);
+	DestroyParallelContext(leader->pcxt);
+	ExitParallelMode();
+	pfree(leader);
+}
+
+/*
+ * Record a participant's ambuild statistics, and whether it encountered a
+ * broken HOT chain, and notify the leader that it's done.
+ */
+void
+index_parallel_build_report(IndexBuildShared *shared, double reltuples,
+							double indtuples, bool brokenhotchain)
+{
+	SpinLockAcquire(&shared->mutex);
+	shared->nparticipantsdone++;
+	shared->reltuples += reltuples;
+	shared->indtuples += indtuples;
+	if (brokenhotchain)
+		shared->brokenhotchain = true;
+	SpinLockRelease(&shared->mutex);
+
+	/* Notify leader */
+	ConditionVariableSignal(&shared->workersdonecv);
+}
+
+/*
+ * Set up a launched parallel worker for its share of the build.
+ *
+ * Opens the relations with the lock modes known to be obtained by index.c,
+ * and attaches to the shared tuplesort state, if there is one.  Returns the
+ * shared state.
+ */
+IndexBuildShared *
+index_parallel_build_attach(dsm_segment *seg, shm_toc *toc,
+							Relation *heap, Relation *index,
+							Sharedsort **sharedsort)
+{
+	char	   *sharedquery;
+	IndexBuildShared *shared;
+	LOCKMODE	heapLockmode;
+	LOCKMODE	indexLockmode;
+
+	/*
+	 * The only possible status flag that can be set to the parallel worker is
+	 * PROC_IN_SAFE_IC.
+	 */
+	Assert((MyProc->statusFlags == 0) ||
+		   (MyProc->statusFlags == PROC_IN_SAFE_IC));
+
+	/* Set debug_query_string for individual workers first */
+	sharedquery = shm_toc_lookup(toc, PARALLEL_KEY_QUERY_TEXT, true);
+	debug_query_string = sharedquery;
+
+	/* Report the query string from leader */
+	pgstat_report_activity(STATE_RUNNING, debug_query_string);
+
+	/* Look up shared state */
+	shared = shm_toc_lookup(toc, PARALLEL_KEY_INDEX_BUILD_SHARED, false);
+
+	/* Open relations using lock modes known to be obtained by index.c */
+	if (!shared->isconcurrent)
+	{
+		heapLockmode = ShareLock;
+		indexLockmode = AccessExclusiveLock;
+	}
+	else
+	{
+		heapLockmode = ShareUpdateExclusiveLock;
+		indexLockmode = RowExclusiveLock;
+	}
+
+	/* Open relations within worker */
+	*heap = table_open(shared->heaprelid, heapLockmode);
+	*index = index_open(shared->indexrelid, indexLockmode);
+
+	/* Look up shared state private to tuplesort.c */
+	if (sharedsort)
+	{
+		*sharedsort = shm_toc_lookup(toc, PARALLEL_KEY_TUPLESORT, false);
+		tuplesort_attach_shared(*sharedsort, seg);
+	}
+
+	/* Prepare to track buffer usage during parallel execution */
+	InstrStartParallelQuery();
+
+	return shared;
+}
+
+/*
+ * Report WAL/buffer usage of a parallel worker, and close the relations
+ * opened by index_parallel_build_attach().
+ */
+void
+index_parallel_build_detach(shm_toc *toc, IndexBuildShared *shared,
+							Relation heap, Relation index)
+{
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+
+	/* Report WAL/buffer usage during parallel execution */
+	bufferusage = shm_toc_lookup(toc, PARALLEL_KEY_BUFFER_USAGE, false);
+	walusage = shm_toc_lookup(toc, PARALLEL_KEY_WAL_USAGE, false);
+	InstrEndParallelQuery(&bufferusage[ParallelWorkerNumber],
+						  &walusage[ParallelWorkerNumber]);
+
+	if (!shared->isconcurrent)
+	{
+		index_close(index, AccessExclusiveLock);
+		table_close(heap, ShareLock);
+	}
+	else
+	{
+		index_close(index, RowExclusiveLock);
+		table_close(heap, ShareUpdateExclusiveLock);
+	}
+}
@@ -29,6 +29,7 @@
 #include "access/xlog.h"
 #include "access/xloginsert.h"
 #include "miscadmin.h"
+#include "pgstat.h"
 #include "storage/indexfsm.h"
 #include "storage/lmgr.h"
 #include "storage/predicate.h"
@@ -37,7 +38,24 @@
 #include "utils/memutils.h"
 #include "utils/snapmgr.h"
 
+/*
+ * Contents of rel->rd_amcache: a copy of the metapage, plus the shared
+ * buffer (or local buffer, for a temp index) that the fast root page was
+ * last found in.  Remembering the buffer lets _bt_getroot() pin the root
+ * with ReadRecentBuffer(), skipping the buffer mapping table lookup and its
+ * partition lock.  Every index search starts at the root, so that lookup is
+ * a hot spot with many concurrent readers.
+ */
+typedef struct BTMetaCacheData
+{
+	BTMetaPageData meta;		/* must be first */
+	Buffer		rootbuf;		/* recent buffer of btm_fastroot, or
+								 * InvalidBuffer */
+} BTMetaCacheData;
+
 static BTMetaPageData *_bt_getmeta(Relation rel, Buffer metabuf);
+static void _bt_cachemeta(Relation rel, BTMetaPageData *metad);
+static Buffer _bt_getroot_recent(Relation rel, BlockNumber rootblkno);
 static void _bt_log_reuse_page(Relation rel, BlockNumber blkno,
 							   FullTransactionId safexid);
 static void _bt_delitems_delete(Relation rel, Buffer buf,
@@ -171,6 +189,57 @@ _bt_getmeta(Relation rel, Buffer metabuf)
 	return metad;
 }
 
+/*
+ *	_bt_cachemeta() -- Save a copy of the metapage in rel->rd_amcache.
+ */
+static void
+_bt_cachemeta(Relation rel, BTMetaPageData *metad)
+{
+	BTMetaCacheData *cache;
+
+	Assert(rel->rd_amcache == NULL);
+
+	cache = MemoryContextAlloc(rel->rd_indexcxt, sizeof(BTMetaCacheData));
+	memcpy(&cache->meta, metad, sizeof(BTMetaPageData));
+	cache->rootbuf = InvalidBuffer;
+	rel->rd_amcache = cache;
+}
+
+/*
+ *	_bt_getroot_recent() -- Read-lock the cached fast root page.
+ *
+ * Like _bt_getbuf(rel, rootblkno, BT_READ), except that we first try the
+ * buffer the root was found in last time.  That's usually still right, since
+ * the root is about the last page to be evicted.  If it isn't, fall back on
+ * a regular lookup and remember the buffer for next time.
+ */
+static Buffer
+_bt_getroot_recent(Relation rel, BlockNumber rootblkno)
+{
+	BTMetaCacheData *cache = (BTMetaCacheData *) rel->rd_amcache;
+	Buffer		buf;
+
+	if (BufferIsValid(cache->rootbuf) &&
+		ReadRecentBuffer(rel->rd_node, MAIN_FORKNUM, rootblkno,
+						 cache->rootbuf))
+	{
+		/* count it the same way ReadBuffer() would have */
+		pgstat_count_buffer_read(rel);
+		pgstat_count_buffer_hit(rel);
+
+		buf = cache->rootbuf;
+		_bt_lockbuf(rel, buf, BT_READ);
+		_bt_checkpage(rel, buf);
+	}
+	else
+	{
+		buf = _bt_getbuf(rel, rootblkno, BT_READ);
+		cache->rootbuf = buf;
+	}
+
+	return buf;
+}
+
 /*
  * _bt_vacuum_needs_cleanup() -- Checks if index needs cleanup
  *
@@ -349,6 +418,7 @@ _bt_getroot(Relation rel, int access)
 	BlockNumber rootblkno;
 	uint32		rootlevel;
 	BTMetaPageData *metad;
+	BTMetaCacheData *cache;
 
 	/*
 	 * Try to use previously-cached metapage data to find the root.  This
@@ -357,7 +427,7 @@ _bt_getroot(Relation rel, int access)
 	 */
 	if (rel->rd_amcache != NULL)
 	{
-		metad = (BTMetaPageData *) rel->rd_amcache;
+		metad = &((BTMetaCacheData *) rel->rd_amcache)->meta;
 		/* We shouldn't have cached it if any of these fail */
 		Assert(metad->btm_magic == BTREE_MAGIC);
 		Assert(metad->btm_version >= BTREE_MIN_VERSION);
@@ -370,7 +440,7 @@ _bt_getroot(Relation rel, int access)
 		Assert(rootblkno != P_NONE);
 		rootlevel = metad->btm_fastlevel;
 
-		rootbuf = _bt_getbuf(rel, rootblkno, BT_READ);
+		rootbuf = _bt_getroot_recent(rel, rootblkno);
 		rootpage = BufferGetPage(rootbuf);
 		rootopaque = BTPageGetOpaque(rootpage);
 
@@ -520,9 +590,7 @@ _bt_getroot(Relation rel, int access)
 		/*
 		 * Cache the metapage data for next time
 		 */
-		rel->rd_amcache = MemoryContextAlloc(rel->rd_indexcxt,
-											 sizeof(BTMetaPageData));
-		memcpy(rel->rd_amcache, metad, sizeof(BTMetaPageData));
+		_bt_cachemeta(rel, metad);
 
 		/*
 		 * We are done with the metapage; arrange to release it via first
@@ -550,6 +618,11 @@ _bt_getroot(Relation rel, int access)
 			elog(ERROR, "root page %u of index \"%s\" has level %u, expected %u",
 				 rootblkno, RelationGetRelationName(rel),
 				 rootopaque->btpo_level, rootlevel);
+
+		/* Remember where the root is, if it's the one we cached */
+		cache = (BTMetaCacheData *) rel->rd_amcache;
+		if (rootblkno == cache->meta.btm_fastroot)
+			cache->rootbuf = rootbuf;
 	}
 
 	/*
@@ -694,14 +767,12 @@ _bt_getrootheight(Relation rel)
 		/*
 		 * Cache the metapage data for next time
 		 */
-		rel->rd_amcache = MemoryContextAlloc(rel->rd_indexcxt,
-											 sizeof(BTMetaPageData));
-		memcpy(rel->rd_amcache, metad, sizeof(BTMetaPageData));
+		_bt_cachemeta(rel, metad);
 		_bt_relbuf(rel, metabuf);
 	}
 
 	/* Get cached page */
-	metad = (BTMetaPageData *) rel->rd_amcache;
+	metad = &((BTMetaCacheData *) rel->rd_amcache)->meta;
 	/* We shouldn't have cached it if any of these fail */
 	Assert(metad->btm_magic == BTREE_MAGIC);
 	Assert(metad->btm_version >= BTREE_MIN_VERSION);
@@ -767,14 +838,12 @@ _bt_metaversion(Relation rel, bool *heapkeyspace, bool *allequalimage)
 		 * from version 2 to version 3, both of which are !heapkeyspace
 		 * versions.
 		 */
-		rel->rd_amcache = MemoryContextAlloc(rel->rd_indexcxt,
-											 sizeof(BTMetaPageData));
-		memcpy(rel->rd_amcache, metad, sizeof(BTMetaPageData));
+		_bt_cachemeta(rel, metad);
 		_bt_relbuf(rel, metabuf);
 	}
 
 	/* Get cached page */
-	metad = (BTMetaPageData *) rel->rd_amcache;
+	metad = &((BTMetaCacheData *) rel->rd_amcache)->meta;
 	/* We shouldn't have cached it if any of these fail */
 	Assert(metad->btm_magic == BTREE_MAGIC);
 	Assert(metad->btm_version >= BTREE_MIN_VERSION);
@@ -50,6 +50,11 @@
  *
  * BTPARALLEL_DONE indicates that the scan is complete (including error exit).
  * We reach this state once for every distinct combination of array keys.
+ *
+ * Once btps_lastChunk is set, the scan has been divided into key range chunks
+ * (see _bt_chunk_init()), and btps_scanPage is no longer used: participants
+ * claim whole chunks with _bt_parallel_next_chunk() instead of seizing the
+ * scan for each page.  Only the BTPARALLEL_DONE status matters then.
  */
 typedef enum
 {
@@ -71,8 +76,13 @@ typedef struct BTParallelScanDescData
 									 * possible states of parallel scan. */
 	int			btps_arrayKeyCount; /* count indicating number of array scan
 									 * keys processed by parallel scan */
+	OffsetNumber btps_nextChunk;	/* next chunk to be handed out */
+	OffsetNumber btps_lastChunk;	/* last chunk, or InvalidOffsetNumber if
+									 * the scan isn't range-partitioned */
 	slock_t		btps_mutex;		/* protects above variables */
 	ConditionVariable btps_cv;	/* used to synchronize parallel scan */
+	PGAlignedBlock btps_chunkPage;	/* copy of the root page whose downlinks
+									 * delimit the chunks */
 }			BTParallelScanDescData;
 
 typedef struct BTParallelScanDescData *BTParallelScanDesc;
@@ -114,6 +124,7 @@ bthandler(PG_FUNCTION_ARGS)
 	amroutine->amcanparallel = true;
 	amroutine->amcaninclude = true;
 	amroutine->amusemaintenanceworkmem = false;
+	amroutine->amsummarizing = false;
 	amroutine->amparallelvacuumoptions =
 		VACUUM_OPTION_PARALLEL_BULKDEL | VACUUM_OPTION_PARALLEL_COND_CLEANUP;
 	amroutine->amkeytype = InvalidOid;
@@ -365,6 +376,14 @@ btbeginscan(Relation rel, int nkeys, int norderbys)
 	so->arrayKeys = NULL;
 	so->arrayContext = NULL;
 
+	so->skipEnabled = false;
+	so->skipPending = false;
+	so->skipTuple = NULL;		/* until needed */
+
+	so->chunked = false;
+	so->chunkDone = false;
+	so->chunkEndKey = NULL;
+
 	so->killedItems = NULL;		/* until needed */
 	so->numKilled = 0;
 
@@ -403,6 +422,13 @@ btrescan(IndexScanDesc scan, ScanKey scankey, int nscankeys,
 
 	so->markItemIndex = -1;
 	so->arrayKeyCount = 0;
+	so->skipEnabled = false;	/* until _bt_first decides otherwise */
+	so->skipPending = false;
+	so->chunked = false;		/* likewise */
+	so->chunkDone = false;
+	if (so->chunkEndKey != NULL)
+		pfree(so->chunkEndKey);
+	so->chunkEndKey = NULL;
 	BTScanPosUnpinIfPinned(so->markPos);
 	BTScanPosInvalidate(so->markPos);
 
@@ -471,6 +497,10 @@ btendscan(IndexScanDesc scan)
 		MemoryContextDelete(so->arrayContext);
 	if (so->killedItems != NULL)
 		pfree(so->killedItems);
+	if (so->skipTuple != NULL)
+		pfree(so->skipTuple);
+	if (so->chunkEndKey != NULL)
+		pfree(so->chunkEndKey);
 	if (so->currTuples != NULL)
 		pfree(so->currTuples);
 	/* so->markTuples should not be pfree'd, see btrescan */
@@ -560,6 +590,13 @@ btrestrpos(IndexScanDesc scan)
 		}
 		else
 			BTScanPosInvalidate(so->currPos);
+
+		/*
+		 * A pending skip was computed from a page we read after the mark, so
+		 * it no longer applies.  Step right from the marked page normally;
+		 * the next page we read will decide whether to skip again.
+		 */
+		so->skipPending = false;
 	}
 }
 
@@ -584,6 +621,8 @@ btinitparallelscan(void *target)
 	bt_target->btps_scanPage = InvalidBlockNumber;
 	bt_target->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
 	bt_target->btps_arrayKeyCount = 0;
+	bt_target->btps_nextChunk = InvalidOffsetNumber;
+	bt_target->btps_lastChunk = InvalidOffsetNumber;
 	ConditionVariableInit(&bt_target->btps_cv);
 }
 
@@ -610,6 +649,8 @@ btparallelrescan(IndexScanDesc scan)
 	btscan->btps_scanPage = InvalidBlockNumber;
 	btscan->btps_pageStatus = BTPARALLEL_NOT_INITIALIZED;
 	btscan->btps_arrayKeyCount = 0;
+	btscan->btps_nextChunk = InvalidOffsetNumber;
+	btscan->btps_lastChunk = InvalidOffsetNumber;
 	SpinLockRelease(&btscan->btps_mutex);
 }
 
@@ -629,6 +670,10 @@ btparallelrescan(IndexScanDesc scan)
  * true and set *pageno to P_NONE; after that, further attempts to seize the
  * scan will return false.
  *
+ * If the scan has been divided into key range chunks, we return true without
+ * seizing anything, and set so->chunked to tell the caller to claim a chunk
+ * with _bt_parallel_next_chunk() instead.
+ *
  * Callers should ignore the value of pageno if the return value is false.
  */
 bool
@@ -664,6 +709,12 @@ _bt_parallel_seize(IndexScanDesc scan, BlockNumber *pageno)
 			 */
 			status = false;
 		}
+		else if (btscan->btps_lastChunk != InvalidOffsetNumber)
+		{
+			/* The scan is range-partitioned, so there's nothing to wait for */
+			so->chunked = true;
+			exit_loop = true;
+		}
 		else if (pageStatus != BTPARALLEL_ADVANCING)
 		{
 			/*
@@ -746,6 +797,95 @@ _bt_parallel_done(IndexScanDesc scan)
 		ConditionVariableBroadcast(&btscan->btps_cv);
 }
 
+/*
+ * _bt_parallel_chunks_init() -- Divide the scan into key range chunks.
+ *
+ * Called by the process that has seized the scan to position it initially.
+ * Each downlink on rootpage delimits one chunk, and chunks are identified by
+ * the downlinks' offset numbers.  The caller keeps the chunk numbered first
+ * for itself; the rest are handed out in key space order by
+ * _bt_parallel_next_chunk().  This also releases the scan, since nobody will
+ * need to seize it again.
+ *
+ * Returns the lower bound of the chunk following the caller's, which points
+ * into shared memory, or NULL if the caller's chunk is the last one.
+ */
+IndexTuple
+_bt_parallel_chunks_init(IndexScanDesc scan, Page rootpage, OffsetNumber first)
+{
+	ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+	BTParallelScanDesc btscan;
+	OffsetNumber last = PageGetMaxOffsetNumber(rootpage);
+	Page		page;
+
+	btscan = (BTParallelScanDesc) OffsetToPointer((void *) parallel_scan,
+												  parallel_scan->ps_offset);
+
+	/* No one else can look at the copy until we set btps_lastChunk */
+	page = btscan->btps_chunkPage.data;
+	memcpy(page, rootpage, BLCKSZ);
+
+	SpinLockAcquire(&btscan->btps_mutex);
+	btscan->btps_nextChunk = OffsetNumberNext(first);
+	btscan->btps_lastChunk = last;
+	btscan->btps_pageStatus = BTPARALLEL_IDLE;
+	SpinLockRelease(&btscan->btps_mutex);
+
+	/* wake up all the workers waiting to seize the scan */
+	ConditionVariableBroadcast(&btscan->btps_cv);
+
+	if (first >= last)
+		return NULL;
+	return (IndexTuple) PageGetItem(page,
+									PageGetItemId(page, OffsetNumberNext(first)));
+}
+
+/*
+ * _bt_parallel_next_chunk() -- Claim the next unscanned key range chunk.
+ *
+ * On success, sets *lowbound to the separator key that starts the chunk, and
+ * *highbound to the one that starts the following chunk (or NULL if this is
+ * the last chunk).  Both point into shared memory.  Returns false if there
+ * are no chunks left to scan, or the scan has already been marked done.
+ */
+bool
+_bt_parallel_next_chunk(IndexScanDesc scan, IndexTuple *lowbound,
+						IndexTuple *highbound)
+{
+	ParallelIndexScanDesc parallel_scan = scan->parallel_scan;
+	BTParallelScanDesc btscan;
+	OffsetNumber chunk = InvalidOffsetNumber;
+	OffsetNumber last = InvalidOffsetNumber;
+	Page		page;
+
+	btscan = (BTParallelScanDesc) OffsetToPointer((void *) parallel_scan,
+												  parallel_scan->ps_offset);
+
+	SpinLockAcquire(&btscan->btps_mutex);
+	if (btscan->btps_pageStatus != BTPARALLEL_DONE &&
+		btscan->btps_nextChunk <= btscan->btps_lastChunk)
+	{
+		chunk = btscan->btps_nextChunk;
+		last = btscan->btps_lastChunk;
+		btscan->btps_nextChunk = OffsetNumberNext(chunk);
+	}
+	SpinLockRelease(&btscan->btps_mutex);
+
+	if (chunk == InvalidOffsetNumber)
+		return false;
+
+	page = btscan->btps_chunkPage.data;
+	*lowbound = (IndexTuple) PageGetItem(page, PageGetItemId(page, chunk));
+	if (chunk < last)
+		*highbound = (IndexTuple) PageGetItem(page,
+											  PageGetItemId(page,
+															OffsetNumberNext(chunk)));
+	else
+		*highbound = NULL;
+
+	return true;
+}
+
 /*
  * _bt_parallel_advance_array_keys() -- Advances the parallel scan for array
  *			keys.
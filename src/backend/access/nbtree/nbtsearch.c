@@ -28,6 +28,8 @@ static void _bt_drop_lock_and_maybe_pin(IndexScanDesc scan, BTScanPos sp);
 static OffsetNumber _bt_binsrch(Relation rel, BTScanInsert key, Buffer buf);
 static int	_bt_binsrch_posting(BTScanInsert key, Page page,
 								OffsetNumber offnum);
+static int32 _bt_compare_prefix(Relation rel, BTScanInsert key, Page page,
+								OffsetNumber offnum, AttrNumber *cmpcol);
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir,
 						 OffsetNumber offnum);
 static void _bt_saveitem(BTScanOpaque so, int itemIndex,
@@ -42,7 +44,19 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
 static bool _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir);
 static bool _bt_parallel_readpage(IndexScanDesc scan, BlockNumber blkno,
 								  ScanDirection dir);
+static void _bt_chunk_init(IndexScanDesc scan, BTScanInsert key,
+						   ScanDirection dir);
+static Buffer _bt_chunk_start(IndexScanDesc scan, OffsetNumber *offnum);
+static OffsetNumber _bt_chunk_binsrch(Relation rel, BTScanInsert key,
+									  Page page);
 static Buffer _bt_walk_left(Relation rel, Buffer buf, Snapshot snapshot);
+static void _bt_skip_setup(IndexScanDesc scan);
+static void _bt_skip_mkbound(Relation rel, ScanKey cur, ScanKey bound);
+static void _bt_skip_mkkey(IndexScanDesc scan, IndexTuple itup,
+						   ScanKey bound, bool nextkey, BTScanInsert key);
+static void _bt_skip_check(IndexScanDesc scan, Page page,
+						   OffsetNumber maxoff);
+static Buffer _bt_skip_search(IndexScanDesc scan, OffsetNumber *offnum);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
 static inline void _bt_initialize_more_data(BTScanOpaque so, ScanDirection dir);
 
@@ -345,6 +359,8 @@ _bt_binsrch(Relation rel,
 				high;
 	int32		result,
 				cmpval;
+	AttrNumber	lowcmpcol = 1,
+				highcmpcol = 1;
 
 	page = BufferGetPage(buf);
 	opaque = BTPageGetOpaque(page);
@@ -378,6 +394,15 @@ _bt_binsrch(Relation rel,
 	 * 'low' are <= scan key, all slots at or after 'high' are > scan key.
 	 *
 	 * We can fall out when high == low.
+	 *
+	 * We also track how many leading key attributes of the items bounding
+	 * the search (the slots just before 'low' and at 'high') are known to be
+	 * equal to the scan key.  Items are sorted, so every item between the two
+	 * bounds must have the same values for whichever attributes both bounds
+	 * have in common with the scan key, and _bt_compare_prefix() can skip
+	 * them.  This is a big win for multi-column indexes whose leading columns
+	 * have few distinct values, since comparing long equal prefixes (text in
+	 * particular) is the dominant cost of the search.
 	 */
 	high++;						/* establish the loop invariant for high */
 
@@ -386,15 +411,22 @@ _bt_binsrch(Relation rel,
 	while (high > low)
 	{
 		OffsetNumber mid = low + ((high - low) / 2);
+		AttrNumber	cmpcol = Min(lowcmpcol, highcmpcol);
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
-		result = _bt_compare(rel, key, page, mid);
+		result = _bt_compare_prefix(rel, key, page, mid, &cmpcol);
 
 		if (result >= cmpval)
+		{
 			low = mid + 1;
+			lowcmpcol = cmpcol;
+		}
 		else
+		{
 			high = mid;
+			highcmpcol = cmpcol;
+		}
 	}
 
 	/*
@@ -449,6 +481,8 @@ _bt_binsrch_insert(Relation rel, BTInsertState insertstate)
 				stricthigh;
 	int32		result,
 				cmpval;
+	AttrNumber	lowcmpcol = 1,
+				highcmpcol = 1;
 
 	page = BufferGetPage(insertstate->buf);
 	opaque = BTPageGetOpaque(page);
@@ -488,6 +522,11 @@ _bt_binsrch_insert(Relation rel, BTInsertState insertstate)
 	 * at or after 'high' are >= scan key.  'stricthigh' is > scan key, and is
 	 * maintained to save additional search effort for caller.
 	 *
+	 * Equal leading attributes of the bounds are skipped just like in
+	 * _bt_binsrch().  We don't remember them across calls, so a search that
+	 * restarts from cached bounds begins by comparing from the first
+	 * attribute again.
+	 *
 	 * We can fall out when high == low.
 	 */
 	if (!insertstate->bounds_valid)
@@ -499,16 +538,21 @@ _bt_binsrch_insert(Relation rel, BTInsertState insertstate)
 	while (high > low)
 	{
 		OffsetNumber mid = low + ((high - low) / 2);
+		AttrNumber	cmpcol = Min(lowcmpcol, highcmpcol);
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
-		result = _bt_compare(rel, key, page, mid);
+		result = _bt_compare_prefix(rel, key, page, mid, &cmpcol);
 
 		if (result >= cmpval)
+		{
 			low = mid + 1;
+			lowcmpcol = cmpcol;
+		}
 		else
 		{
 			high = mid;
+			highcmpcol = cmpcol;
 			if (result != 0)
 				stricthigh = high;
 		}
@@ -657,6 +701,28 @@ _bt_compare(Relation rel,
 			BTScanInsert key,
 			Page page,
 			OffsetNumber offnum)
+{
+	AttrNumber	cmpcol = 1;
+
+	return _bt_compare_prefix(rel, key, page, offnum, &cmpcol);
+}
+
+/*
+ *	_bt_compare_prefix() -- _bt_compare(), skipping a known-equal prefix.
+ *
+ * *cmpcol is the first key attribute that is not already known to be equal
+ * between the scankey and the tuple at offnum; comparison starts there.  On
+ * return it is set to the attribute that decided the result, or to one past
+ * the last compared attribute when all of them were equal.  Callers use this
+ * to skip attributes during a binary search (see _bt_binsrch()).  Passing 1
+ * gives exactly the behavior of _bt_compare().
+ */
+static int32
+_bt_compare_prefix(Relation rel,
+				   BTScanInsert key,
+				   Page page,
+				   OffsetNumber offnum,
+				   AttrNumber *cmpcol)
 {
 	TupleDesc	itupdesc = RelationGetDescr(rel);
 	BTPageOpaque opaque = BTPageGetOpaque(page);
@@ -676,7 +742,10 @@ _bt_compare(Relation rel,
 	 * --- see NOTE above.
 	 */
 	if (!P_ISLEAF(opaque) && offnum == P_FIRSTDATAKEY(opaque))
+	{
+		*cmpcol = 1;
 		return 1;
+	}
 
 	itup = (IndexTuple) PageGetItem(page, PageGetItemId(page, offnum));
 	ntupatts = BTreeTupleGetNAtts(itup, rel);
@@ -696,8 +765,9 @@ _bt_compare(Relation rel,
 	ncmpkey = Min(ntupatts, key->keysz);
 	Assert(key->heapkeyspace || ncmpkey == key->keysz);
 	Assert(!BTreeTupleIsPosting(itup) || key->allequalimage);
-	scankey = key->scankeys;
-	for (int i = 1; i <= ncmpkey; i++)
+	Assert(*cmpcol >= 1);
+	scankey = key->scankeys + (*cmpcol - 1);
+	for (int i = *cmpcol; i <= ncmpkey; i++)
 	{
 		Datum		datum;
 		bool		isNull;
@@ -741,11 +811,17 @@ _bt_compare(Relation rel,
 
 		/* if the keys are unequal, return the difference */
 		if (result != 0)
+		{
+			*cmpcol = i;
 			return result;
+		}
 
 		scankey++;
 	}
 
+	/* All compared attributes are equal; later callers may skip them */
+	*cmpcol = Max(*cmpcol, ncmpkey + 1);
+
 	/*
 	 * All non-truncated attributes (other than heap TID) were found to be
 	 * equal.  Treat truncated attributes as minus infinity when scankey has a
@@ -898,6 +974,9 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 		return false;
 	}
 
+	/* See if the scan will be able to skip over useless leaf pages */
+	_bt_skip_setup(scan);
+
 	/*
 	 * For parallel scans, get the starting page from shared state. If the
 	 * scan has not started, proceed to find out first leaf page in the usual
@@ -909,6 +988,14 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 		status = _bt_parallel_seize(scan, &blkno);
 		if (!status)
 			return false;
+		else if (so->chunked)
+		{
+			/* The scan is range-partitioned, so go claim a chunk of it */
+			so->chunkDone = true;
+			if (!_bt_parallel_readpage(scan, InvalidBlockNumber, dir))
+				return false;
+			goto readcomplete;
+		}
 		else if (blkno == P_NONE)
 		{
 			_bt_parallel_done(scan);
@@ -1359,6 +1446,9 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 	inskey.scantid = NULL;
 	inskey.keysz = keysCount;
 
+	/* Divide up a parallel scan, starting from the chunk we're about to read */
+	_bt_chunk_init(scan, &inskey, dir);
+
 	/*
 	 * Use the manufactured insertion scan key to descend the tree and
 	 * position ourselves on the target leaf page.
@@ -1539,7 +1629,7 @@ _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum)
 	opaque = BTPageGetOpaque(page);
 
 	/* allow next page be processed by parallel worker */
-	if (scan->parallel_scan)
+	if (scan->parallel_scan && !so->chunked)
 	{
 		if (ScanDirectionIsForward(dir))
 			_bt_parallel_release(scan, opaque->btpo_next);
@@ -1548,10 +1638,38 @@ _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum)
 	}
 
 	continuescan = true;		/* default assumption */
+	so->skipPending = false;	/* likewise */
 	indnatts = IndexRelationGetNumberOfAttributes(scan->indexRelation);
 	minoff = P_FIRSTDATAKEY(opaque);
 	maxoff = PageGetMaxOffsetNumber(page);
 
+	/*
+	 * When this page is the last one in our key range chunk, items from the
+	 * start of the next chunk onward are left for whoever claims that chunk.
+	 * The boundary is compared against the high key with pivotsearch set, so
+	 * that a high key that equals it after suffix truncation counts as
+	 * reaching it.
+	 */
+	if (so->chunkEndKey != NULL && ScanDirectionIsForward(dir))
+	{
+		bool		lastpage = P_RIGHTMOST(opaque);
+
+		if (!lastpage)
+		{
+			so->chunkEndKey->pivotsearch = true;
+			lastpage = (_bt_compare(scan->indexRelation, so->chunkEndKey,
+									page, P_HIKEY) <= 0);
+			so->chunkEndKey->pivotsearch = false;
+		}
+		if (lastpage)
+		{
+			maxoff = OffsetNumberPrev(_bt_chunk_binsrch(scan->indexRelation,
+														so->chunkEndKey,
+														page));
+			so->chunkDone = true;
+		}
+	}
+
 	/*
 	 * We note the buffer's block number so that we can release the pin later.
 	 * This allows us to re-read the buffer if it is needed again for hinting.
@@ -1667,6 +1785,8 @@ _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum)
 
 		if (!continuescan)
 			so->currPos.moreRight = false;
+		else if (so->skipEnabled)
+			_bt_skip_check(scan, page, maxoff);
 
 		Assert(itemIndex <= MaxTIDsPerBTreePage);
 		so->currPos.firstItem = 0;
@@ -1904,7 +2024,7 @@ _bt_steppage(IndexScanDesc scan, ScanDirection dir)
 	if (ScanDirectionIsForward(dir))
 	{
 		/* Walk right to the next page with data */
-		if (scan->parallel_scan != NULL)
+		if (scan->parallel_scan != NULL && !so->chunked)
 		{
 			/*
 			 * Seize the scan to get the next block number; if the scan has
@@ -1991,11 +2111,14 @@ _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
 	{
 		for (;;)
 		{
+			OffsetNumber startoff = InvalidOffsetNumber;
+
 			/*
 			 * if we're at end of scan, give up and mark parallel scan as
-			 * done, so that all the workers can finish their scan
+			 * done, so that all the workers can finish their scan.  Reaching
+			 * the rightmost page only ends the current chunk, though.
 			 */
-			if (blkno == P_NONE || !so->currPos.moreRight)
+			if (!so->currPos.moreRight || (blkno == P_NONE && !so->chunkDone))
 			{
 				_bt_parallel_done(scan);
 				BTScanPosInvalidate(so->currPos);
@@ -2003,8 +2126,33 @@ _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
 			}
 			/* check for interrupts while we're not holding any buffer lock */
 			CHECK_FOR_INTERRUPTS();
-			/* step right one page */
-			so->currPos.buf = _bt_getbuf(rel, blkno, BT_READ);
+			if (so->skipPending && so->skipPage == so->currPos.currPage)
+			{
+				/* skip ahead to the next page that might have matches */
+				so->currPos.buf = _bt_skip_search(scan, &startoff);
+				if (!BufferIsValid(so->currPos.buf))
+				{
+					BTScanPosInvalidate(so->currPos);
+					return false;
+				}
+				blkno = BufferGetBlockNumber(so->currPos.buf);
+			}
+			else if (so->chunkDone)
+			{
+				/* descend to the start of the next unclaimed chunk */
+				so->currPos.buf = _bt_chunk_start(scan, &startoff);
+				if (!BufferIsValid(so->currPos.buf))
+				{
+					BTScanPosInvalidate(so->currPos);
+					return false;
+				}
+				blkno = BufferGetBlockNumber(so->currPos.buf);
+			}
+			else
+			{
+				/* step right one page */
+				so->currPos.buf = _bt_getbuf(rel, blkno, BT_READ);
+			}
 			page = BufferGetPage(so->currPos.buf);
 			TestForOldSnapshot(scan->xs_snapshot, rel, page);
 			opaque = BTPageGetOpaque(page);
@@ -2014,17 +2162,18 @@ _bt_readnextpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
 				PredicateLockPage(rel, blkno, scan->xs_snapshot);
 				/* see if there are any matches on this page */
 				/* note that this will clear moreRight if we can stop */
-				if (_bt_readpage(scan, dir, P_FIRSTDATAKEY(opaque)))
+				if (_bt_readpage(scan, dir,
+								 Max(startoff, P_FIRSTDATAKEY(opaque))))
 					break;
 			}
-			else if (scan->parallel_scan != NULL)
+			else if (scan->parallel_scan != NULL && !so->chunked)
 			{
 				/* allow next page be processed by parallel worker */
 				_bt_parallel_release(scan, opaque->btpo_next);
 			}
 
 			/* nope, keep going */
-			if (scan->parallel_scan != NULL)
+			if (scan->parallel_scan != NULL && !so->chunked)
 			{
 				_bt_relbuf(rel, so->currPos.buf);
 				status = _bt_parallel_seize(scan, &blkno);
@@ -2170,6 +2319,161 @@ _bt_parallel_readpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
 	return true;
 }
 
+/*
+ *	_bt_chunk_init() -- Divide a parallel scan into key range chunks
+ *
+ * Participants in a parallel scan ordinarily take turns advancing it a page
+ * at a time: whoever has seized the scan must read the next page's right-link
+ * before anyone else can move on, so the scan as a whole can go no faster
+ * than one process stepping right.  In indexes of three or more levels, we
+ * instead divide the key space into chunks using the separator keys on the
+ * root page, so that each participant can descend to a chunk of its own and
+ * walk it with no further coordination.  Chunk boundaries are rechecked
+ * against each page's high key as we go (see _bt_readpage), so concurrent
+ * page splits and deletions are no more of a problem than in a serial scan.
+ *
+ * Called by the participant that positions the scan initially, just before it
+ * descends.  key is the insertion scankey it uses for that, or NULL when it
+ * starts from the leftmost leaf page.  The chunk containing that position is
+ * ours, and the ones after it are handed out by _bt_parallel_next_chunk.
+ *
+ * Only forward scans without array keys are divided up this way.
+ */
+static void
+_bt_chunk_init(IndexScanDesc scan, BTScanInsert key, ScanDirection dir)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	bool		heapkeyspace;
+	bool		allequalimage;
+	Buffer		rootbuf;
+	Page		page;
+	BTPageOpaque opaque;
+	OffsetNumber first;
+	IndexTuple	highbound;
+
+	if (scan->parallel_scan == NULL || !ScanDirectionIsForward(dir) ||
+		so->numArrayKeys != 0)
+		return;
+
+	/*
+	 * Chunk boundaries must be unambiguous, which requires heap TID as a
+	 * tiebreaker column.
+	 */
+	_bt_metaversion(rel, &heapkeyspace, &allequalimage);
+	if (!heapkeyspace)
+		return;
+
+	rootbuf = _bt_getroot(rel, BT_READ);
+	if (!BufferIsValid(rootbuf))
+		return;
+	page = BufferGetPage(rootbuf);
+	opaque = BTPageGetOpaque(page);
+
+	/*
+	 * With a root at level 1, each chunk would be a single leaf page, which
+	 * would be no cheaper to reach by descending than by stepping right.
+	 */
+	if (opaque->btpo_level < 2)
+	{
+		_bt_relbuf(rel, rootbuf);
+		return;
+	}
+
+	if (key != NULL)
+		first = _bt_binsrch(rel, key, rootbuf);
+	else
+		first = P_FIRSTDATAKEY(opaque);
+
+	/* Nothing to divide up if the scan starts in the last chunk */
+	if (first < PageGetMaxOffsetNumber(page))
+	{
+		highbound = _bt_parallel_chunks_init(scan, page, first);
+		so->chunked = true;
+		so->chunkDone = false;
+		so->chunkEndKey = _bt_mkscankey(rel, highbound);
+	}
+
+	_bt_relbuf(rel, rootbuf);
+}
+
+/*
+ *	_bt_chunk_start() -- Claim the next chunk of a range-partitioned scan
+ *
+ * Descends to the leaf page where the chunk starts, and returns it pinned and
+ * read-locked, with *offnum set to the chunk's first item on the page.
+ * Returns InvalidBuffer if no chunks are left.
+ */
+static Buffer
+_bt_chunk_start(IndexScanDesc scan, OffsetNumber *offnum)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	IndexTuple	lowbound;
+	IndexTuple	highbound;
+	BTScanInsert lowkey;
+	BTStack		stack;
+	Buffer		buf;
+
+	if (so->chunkEndKey != NULL)
+	{
+		pfree(so->chunkEndKey);
+		so->chunkEndKey = NULL;
+	}
+
+	if (!_bt_parallel_next_chunk(scan, &lowbound, &highbound))
+		return InvalidBuffer;
+
+	so->chunkDone = false;
+	if (highbound != NULL)
+		so->chunkEndKey = _bt_mkscankey(rel, highbound);
+
+	lowkey = _bt_mkscankey(rel, lowbound);
+	stack = _bt_search(rel, lowkey, &buf, BT_READ, scan->xs_snapshot);
+	_bt_freestack(stack);
+
+	if (BufferIsValid(buf))
+		*offnum = _bt_chunk_binsrch(rel, lowkey, BufferGetPage(buf));
+	pfree(lowkey);
+
+	return buf;
+}
+
+/*
+ *	_bt_chunk_binsrch() -- Find the first item on a leaf page that belongs to
+ *		the chunk that key starts
+ *
+ * key was built from a separator key, and so may have scantid set, which
+ * _bt_binsrch doesn't allow on leaf pages.  A posting list tuple whose TID
+ * range covers the boundary compares as equal, and goes with the later chunk
+ * as a whole.  Returns maxoff + 1 if every item belongs to an earlier chunk.
+ */
+static OffsetNumber
+_bt_chunk_binsrch(Relation rel, BTScanInsert key, Page page)
+{
+	BTPageOpaque opaque = BTPageGetOpaque(page);
+	OffsetNumber low,
+				high;
+
+	Assert(P_ISLEAF(opaque));
+	Assert(!key->nextkey && !key->pivotsearch);
+
+	low = P_FIRSTDATAKEY(opaque);
+	high = OffsetNumberNext(PageGetMaxOffsetNumber(page));
+
+	while (high > low)
+	{
+		OffsetNumber mid = low + ((high - low) / 2);
+
+		if (_bt_compare(rel, key, page, mid) > 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return low;
+}
+
 /*
  * _bt_walk_left() -- step left one page, if possible
  *
@@ -2403,6 +2707,7 @@ _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
 	 * version of _bt_search().  We don't maintain a stack since we know we
 	 * won't need it.
 	 */
+	_bt_chunk_init(scan, NULL, dir);
 	buf = _bt_get_endpoint(rel, 0, ScanDirectionIsBackward(dir), scan->xs_snapshot);
 
 	if (!BufferIsValid(buf))
@@ -2494,3 +2799,267 @@ _bt_initialize_more_data(BTScanOpaque so, ScanDirection dir)
 	so->numKilled = 0;			/* just paranoia */
 	so->markItemIndex = -1;		/* ditto */
 }
+
+/*
+ *	_bt_skip_setup() -- decide whether a scan may skip over leaf pages
+ *
+ * A scan with no key on the index's first column can't be positioned by
+ * _bt_first(), and _bt_checkkeys() never ends it early, so it reads every
+ * leaf page.  When the second column is constrained, though, the tuples that
+ * can match for any one first-column value are contiguous, and nothing
+ * between one such run and the next can match.  We then let _bt_readpage()
+ * check whether the rest of the page's last first-column value is useless
+ * (see _bt_skip_check()), and if so, the next step descends the tree again
+ * to reach the next interesting point instead of walking right through the
+ * pages in between.
+ *
+ * This is only done for serial scans without array keys on heapkeyspace
+ * indexes.  Backward scans never skip.
+ */
+static void
+_bt_skip_setup(IndexScanDesc scan)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	bool		heapkeyspace,
+				allequalimage;
+
+	so->skipEnabled = false;
+	so->skipPending = false;
+	so->skipHasLow = false;
+	so->skipHasHigh = false;
+
+	if (scan->parallel_scan != NULL || so->numArrayKeys != 0 ||
+		so->numberOfKeys == 0 || so->keyData[0].sk_attno != 2)
+		return;
+
+	_bt_metaversion(rel, &heapkeyspace, &allequalimage);
+	if (!heapkeyspace)
+		return;
+
+	/*
+	 * Pick the keys that bound the second column.  If cross-type operators
+	 * kept _bt_preprocess_keys() from eliminating redundant keys we just use
+	 * the first usable one for each end; any of them is a valid bound.
+	 */
+	for (int i = 0; i < so->numberOfKeys; i++)
+	{
+		ScanKey		cur = so->keyData + i;
+
+		if (cur->sk_attno != 2)
+			break;
+
+		/* IS NULL, IS NOT NULL and row comparisons aren't used */
+		if (cur->sk_flags & (SK_ISNULL | SK_ROW_HEADER))
+			continue;
+
+		switch (cur->sk_strategy)
+		{
+			case BTEqualStrategyNumber:
+				_bt_skip_mkbound(rel, cur, &so->skipLowKey);
+				_bt_skip_mkbound(rel, cur, &so->skipHighKey);
+				so->skipHasLow = so->skipHasHigh = true;
+				break;
+			case BTGreaterEqualStrategyNumber:
+			case BTGreaterStrategyNumber:
+				if (!so->skipHasLow)
+				{
+					_bt_skip_mkbound(rel, cur, &so->skipLowKey);
+					so->skipHasLow = true;
+				}
+				break;
+			case BTLessEqualStrategyNumber:
+			case BTLessStrategyNumber:
+				if (!so->skipHasHigh)
+				{
+					_bt_skip_mkbound(rel, cur, &so->skipHighKey);
+					so->skipHasHigh = true;
+				}
+				break;
+		}
+	}
+
+	so->skipEnabled = so->skipHasLow || so->skipHasHigh;
+	if (so->skipEnabled && so->skipTuple == NULL)
+		so->skipTuple = (IndexTuple) palloc(BLCKSZ);
+}
+
+/*
+ * Transform search-style scan key cur on the second index column into an
+ * insertion scan key entry, the same way _bt_first() does.
+ */
+static void
+_bt_skip_mkbound(Relation rel, ScanKey cur, ScanKey bound)
+{
+	int			i = cur->sk_attno - 1;
+
+	if (cur->sk_subtype == rel->rd_opcintype[i] ||
+		cur->sk_subtype == InvalidOid)
+	{
+		FmgrInfo   *procinfo;
+
+		procinfo = index_getprocinfo(rel, cur->sk_attno, BTORDER_PROC);
+		ScanKeyEntryInitializeWithInfo(bound,
+									   cur->sk_flags,
+									   cur->sk_attno,
+									   InvalidStrategy,
+									   cur->sk_subtype,
+									   cur->sk_collation,
+									   procinfo,
+									   cur->sk_argument);
+	}
+	else
+	{
+		RegProcedure cmp_proc;
+
+		cmp_proc = get_opfamily_proc(rel->rd_opfamily[i],
+									 rel->rd_opcintype[i],
+									 cur->sk_subtype,
+									 BTORDER_PROC);
+		if (!RegProcedureIsValid(cmp_proc))
+			elog(ERROR, "missing support function %d(%u,%u) for attribute %d of index \"%s\"",
+				 BTORDER_PROC, rel->rd_opcintype[i], cur->sk_subtype,
+				 cur->sk_attno, RelationGetRelationName(rel));
+		ScanKeyEntryInitialize(bound,
+							   cur->sk_flags,
+							   cur->sk_attno,
+							   InvalidStrategy,
+							   cur->sk_subtype,
+							   cur->sk_collation,
+							   cmp_proc,
+							   cur->sk_argument);
+	}
+}
+
+/*
+ * Build an insertion scan key made of itup's first column value, followed by
+ * second column bound if that isn't NULL.
+ *
+ * The key points into itup, so it's only valid as long as itup is.
+ */
+static void
+_bt_skip_mkkey(IndexScanDesc scan, IndexTuple itup, ScanKey bound,
+			   bool nextkey, BTScanInsert key)
+{
+	Relation	rel = scan->indexRelation;
+	Datum		datum;
+	bool		isNull;
+
+	datum = index_getattr(itup, 1, RelationGetDescr(rel), &isNull);
+	ScanKeyEntryInitializeWithInfo(&key->scankeys[0],
+								   (isNull ? SK_ISNULL : 0) |
+								   (rel->rd_indoption[0] << SK_BT_INDOPTION_SHIFT),
+								   1,
+								   InvalidStrategy,
+								   InvalidOid,
+								   rel->rd_indcollation[0],
+								   index_getprocinfo(rel, 1, BTORDER_PROC),
+								   datum);
+	key->keysz = 1;
+	if (bound != NULL)
+	{
+		memcpy(&key->scankeys[1], bound, sizeof(ScanKeyData));
+		key->keysz = 2;
+	}
+
+	_bt_metaversion(rel, &key->heapkeyspace, &key->allequalimage);
+	key->anynullkeys = false;	/* unused */
+	key->nextkey = nextkey;
+	key->pivotsearch = false;
+	key->scantid = NULL;
+}
+
+/*
+ *	_bt_skip_check() -- see if the next step of a forward scan should skip
+ *
+ * Called by _bt_readpage() after it has read all of a leaf page without
+ * ending the scan.  Looks at the page's last item to determine the first
+ * point beyond it that could possibly match, and arranges for
+ * _bt_readnextpage() to descend straight there when that point is past the
+ * start of the right sibling page.
+ */
+static void
+_bt_skip_check(IndexScanDesc scan, Page page, OffsetNumber maxoff)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	BTPageOpaque opaque = BTPageGetOpaque(page);
+	IndexTuple	itup;
+	BTScanInsertData key;
+	bool		nextgroup = false;
+
+	Assert(so->skipEnabled && !so->skipPending);
+
+	if (P_RIGHTMOST(opaque) || maxoff < P_FIRSTDATAKEY(opaque))
+		return;
+
+	itup = (IndexTuple) PageGetItem(page, PageGetItemId(page, maxoff));
+
+	/*
+	 * If the last item is already past the second column's end bound, no
+	 * later item with the same first column value can match, so continue
+	 * with the next first column value.  Otherwise, if the last item is
+	 * still before the second column's start bound, continue at the start
+	 * bound for the same first column value.
+	 */
+	if (so->skipHasHigh)
+	{
+		_bt_skip_mkkey(scan, itup, &so->skipHighKey, false, &key);
+		nextgroup = (_bt_compare(rel, &key, page, maxoff) < 0);
+	}
+	if (nextgroup)
+		_bt_skip_mkkey(scan, itup, NULL, true, &key);
+	else
+	{
+		if (!so->skipHasLow)
+			return;
+		_bt_skip_mkkey(scan, itup, &so->skipLowKey, false, &key);
+		if (_bt_compare(rel, &key, page, maxoff) <= 0)
+			return;
+	}
+
+	/*
+	 * A new descent costs more than stepping right, and only pays off when
+	 * it lets us avoid reading at least the right sibling.  Everything on
+	 * the right sibling is >= our high key, so skip only when the target is
+	 * beyond the high key.
+	 */
+	if (_bt_compare(rel, &key, page, P_HIKEY) < (nextgroup ? 0 : 1))
+		return;
+
+	memcpy(so->skipTuple, itup, IndexTupleSize(itup));
+	so->skipNextGroup = nextgroup;
+	so->skipPage = so->currPos.currPage;
+	so->skipPending = true;
+}
+
+/*
+ *	_bt_skip_search() -- descend to the point chosen by _bt_skip_check()
+ *
+ * Returns the read-locked leaf page and sets *offnum to the first item on it
+ * that the scan must look at.  Returns InvalidBuffer if the index is empty.
+ */
+static Buffer
+_bt_skip_search(IndexScanDesc scan, OffsetNumber *offnum)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	BTScanInsertData key;
+	BTStack		stack;
+	Buffer		buf;
+
+	Assert(so->skipPending);
+	so->skipPending = false;
+
+	_bt_skip_mkkey(scan, so->skipTuple,
+				   so->skipNextGroup ? NULL : &so->skipLowKey,
+				   so->skipNextGroup, &key);
+
+	stack = _bt_search(rel, &key, &buf, BT_READ, scan->xs_snapshot);
+	_bt_freestack(stack);
+
+	if (BufferIsValid(buf))
+		*offnum = _bt_binsrch(rel, &key, buf);
+
+	return buf;
+}
@@ -112,6 +112,9 @@ static void show_hash_info(HashState *hashstate, ExplainState *es);
 static void show_memoize_info(MemoizeState *mstate, List *ancestors,
 							  ExplainState *es);
 static void show_hashagg_info(AggState *hashstate, ExplainState *es);
+static void show_hashagg_spill_info(int depth, int nbatches, int64 smallest,
+									int64 largest, int64 total,
+									ExplainState *es);
 static void show_tidbitmap_info(BitmapHeapScanState *planstate,
 								ExplainState *es);
 static void show_instrumentation_count(const char *qlabel, int which,
@@ -1791,6 +1794,18 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			/* fall through to print additional fields the same as SeqScan */
 			/* FALLTHROUGH */
 		case T_SeqScan:
+			show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
+			if (plan->qual)
+				show_instrumentation_count("Rows Removed by Filter", 1,
+										   planstate, es);
+			/* workers' filters are counted too, though ours may be unused */
+			if (IsA(planstate, SeqScanState) &&
+				(((SeqScanState *) planstate)->runtime_filter_used ||
+				 (planstate->instrument &&
+				  planstate->instrument->nfiltered2 > 0)))
+				show_instrumentation_count("Rows Removed by Runtime Filter", 2,
+										   planstate, es);
+			break;
 		case T_ValuesScan:
 		case T_CteScan:
 		case T_NamedTuplestoreScan:
@@ -3247,6 +3262,34 @@ show_memoize_info(MemoizeState *mstate, List *ancestors, ExplainState *es)
 	}
 }
 
+/*
+ * Show the shape of a hash aggregate's spill: how deep the batches were
+ * repartitioned, and the distribution of tuples over the spilled batches.
+ * nbatches is the number of spilled batches, which must be at least one.
+ */
+static void
+show_hashagg_spill_info(int depth, int nbatches, int64 smallest,
+						int64 largest, int64 total, ExplainState *es)
+{
+	int64		average = total / nbatches;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		appendStringInfo(es->str, "  Spill Depth: %d", depth);
+		appendStringInfo(es->str,
+						 "  Batch Tuples: min=" INT64_FORMAT
+						 " avg=" INT64_FORMAT " max=" INT64_FORMAT,
+						 smallest, average, largest);
+	}
+	else
+	{
+		ExplainPropertyInteger("HashAgg Spill Depth", NULL, depth, es);
+		ExplainPropertyInteger("HashAgg Min Batch Tuples", NULL, smallest, es);
+		ExplainPropertyInteger("HashAgg Avg Batch Tuples", NULL, average, es);
+		ExplainPropertyInteger("HashAgg Max Batch Tuples", NULL, largest, es);
+	}
+}
+
 /*
  * Show information on hash aggregate memory usage and batches.
  */
@@ -3279,6 +3322,15 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 			ExplainPropertyInteger("Peak Memory Usage", "kB", memPeakKb, es);
 			ExplainPropertyInteger("Disk Usage", "kB",
 								   aggstate->hash_disk_used, es);
+			if (aggstate->hash_batches_used > 1)
+				show_hashagg_spill_info(aggstate->hash_spill_depth,
+										aggstate->hash_batches_used - 1,
+										aggstate->hash_smallest_batch,
+										aggstate->hash_largest_batch,
+										aggstate->hash_spilled_tuples, es);
+			if (DO_AGGSPLIT_SKIPFINAL(agg->aggsplit))
+				ExplainPropertyInteger("Flushes", NULL,
+									   aggstate->hash_flushes, es);
 		}
 	}
 	else
@@ -3314,7 +3366,17 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 			{
 				appendStringInfo(es->str, "  Disk Usage: " UINT64_FORMAT "kB",
 								 aggstate->hash_disk_used);
+				show_hashagg_spill_info(aggstate->hash_spill_depth,
+										aggstate->hash_batches_used - 1,
+										aggstate->hash_smallest_batch,
+										aggstate->hash_largest_batch,
+										aggstate->hash_spilled_tuples, es);
 			}
+
+			/* ... and flushes if a partial aggregate emitted groups early */
+			if (aggstate->hash_flushes > 0)
+				appendStringInfo(es->str, "  Flushes: %d",
+								 aggstate->hash_flushes);
 		}
 
 		if (gotone)
@@ -3329,6 +3391,11 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 			AggregateInstrumentation *sinstrument;
 			uint64		hash_disk_used;
 			int			hash_batches_used;
+			int			hash_flushes;
+			int			hash_spill_depth;
+			int64		hash_smallest_batch;
+			int64		hash_largest_batch;
+			int64		hash_spilled_tuples;
 
 			sinstrument = &aggstate->shared_info->sinstrument[n];
 			/* Skip workers that didn't do anything */
@@ -3336,6 +3403,11 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 				continue;
 			hash_disk_used = sinstrument->hash_disk_used;
 			hash_batches_used = sinstrument->hash_batches_used;
+			hash_flushes = sinstrument->hash_flushes;
+			hash_spill_depth = sinstrument->hash_spill_depth;
+			hash_smallest_batch = sinstrument->hash_smallest_batch;
+			hash_largest_batch = sinstrument->hash_largest_batch;
+			hash_spilled_tuples = sinstrument->hash_spilled_tuples;
 			memPeakKb = (sinstrument->hash_mem_peak + 1023) / 1024;
 
 			if (es->workers_state)
@@ -3350,8 +3422,17 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 
 				/* Only display disk usage if we spilled to disk */
 				if (hash_batches_used > 1)
+				{
 					appendStringInfo(es->str, "  Disk Usage: " UINT64_FORMAT "kB",
 									 hash_disk_used);
+					show_hashagg_spill_info(hash_spill_depth,
+											hash_batches_used - 1,
+											hash_smallest_batch,
+											hash_largest_batch,
+											hash_spilled_tuples, es);
+				}
+				if (hash_flushes > 0)
+					appendStringInfo(es->str, "  Flushes: %d", hash_flushes);
 				appendStringInfoChar(es->str, '\n');
 			}
 			else
@@ -3361,6 +3442,15 @@ show_hashagg_info(AggState *aggstate, ExplainState *es)
 				ExplainPropertyInteger("Peak Memory Usage", "kB", memPeakKb,
 									   es);
 				ExplainPropertyInteger("Disk Usage", "kB", hash_disk_used, es);
+				if (hash_batches_used > 1)
+					show_hashagg_spill_info(hash_spill_depth,
+											hash_batches_used - 1,
+											hash_smallest_batch,
+											hash_largest_batch,
+											hash_spilled_tuples, es);
+				if (DO_AGGSPLIT_SKIPFINAL(agg->aggsplit))
+					ExplainPropertyInteger("Flushes", NULL,
+										   hash_flushes, es);
 			}
 
 			if (es->workers_state)
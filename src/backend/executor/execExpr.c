@@ -47,6 +47,7 @@
 #include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/datum.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/typcache.h"
 
@@ -64,6 +65,7 @@ static void ExecInitExprRec(Expr *node, ExprState *state,
 static void ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args,
 						 Oid funcid, Oid inputcollid,
 						 ExprState *state);
+static ExprEvalOp ExecInlineFuncOpcode(Oid funcid);
 static void ExecInitExprSlots(ExprState *state, Node *node);
 static void ExecPushExprSlots(ExprState *state, LastAttnumInfo *info);
 static bool get_last_attnums_walker(Node *node, LastAttnumInfo *info);
@@ -2538,7 +2540,15 @@ ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args, Oid funcid,
 	if (pgstat_track_functions <= flinfo->fn_stats)
 	{
 		if (flinfo->fn_strict && nargs > 0)
-			scratch->opcode = EEOP_FUNCEXPR_STRICT;
+		{
+			/* choose a specialized opcode for common argument counts */
+			if (nargs == 1)
+				scratch->opcode = EEOP_FUNCEXPR_STRICT_1;
+			else if (nargs == 2)
+				scratch->opcode = ExecInlineFuncOpcode(funcid);
+			else
+				scratch->opcode = EEOP_FUNCEXPR_STRICT;
+		}
 		else
 			scratch->opcode = EEOP_FUNCEXPR;
 	}
@@ -2551,6 +2561,45 @@ ExecInitFunc(ExprEvalStep *scratch, Expr *node, List *args, Oid funcid,
 	}
 }
 
+/*
+ * Return the opcode to use for a call of the strict two-argument function
+ * funcid.  Comparisons of int4 and int8 values are common enough in quals
+ * that they're evaluated inline rather than through fmgr.
+ */
+static ExprEvalOp
+ExecInlineFuncOpcode(Oid funcid)
+{
+	switch (funcid)
+	{
+		case F_INT4EQ:
+			return EEOP_INT4_EQ;
+		case F_INT4NE:
+			return EEOP_INT4_NE;
+		case F_INT4LT:
+			return EEOP_INT4_LT;
+		case F_INT4LE:
+			return EEOP_INT4_LE;
+		case F_INT4GT:
+			return EEOP_INT4_GT;
+		case F_INT4GE:
+			return EEOP_INT4_GE;
+		case F_INT8EQ:
+			return EEOP_INT8_EQ;
+		case F_INT8NE:
+			return EEOP_INT8_NE;
+		case F_INT8LT:
+			return EEOP_INT8_LT;
+		case F_INT8LE:
+			return EEOP_INT8_LE;
+		case F_INT8GT:
+			return EEOP_INT8_GT;
+		case F_INT8GE:
+			return EEOP_INT8_GE;
+		default:
+			return EEOP_FUNCEXPR_STRICT_2;
+	}
+}
+
 /*
  * Add expression steps deforming the ExprState's inner/outer/scan slots
  * as much as required by the expression.
@@ -125,6 +125,22 @@ static ExprEvalOpLookup reverse_dispatch_table[EEOP_LAST];
 
 #endif							/* EEO_USE_COMPUTED_GOTO */
 
+/*
+ * EEO_INLINE_COMPARE - evaluate an inlined strict two-argument comparison,
+ * for the EEOP_INT4_* and EEOP_INT8_* steps.
+ */
+#define EEO_INLINE_COMPARE(args, getter, cmpop) \
+	do { \
+		if ((args)[0].isnull || (args)[1].isnull) \
+			*op->resnull = true; \
+		else \
+		{ \
+			*op->resvalue = BoolGetDatum(getter((args)[0].value) cmpop \
+										 getter((args)[1].value)); \
+			*op->resnull = false; \
+		} \
+	} while (0)
+
 #define EEO_NEXT() \
 	do { \
 		op++; \
@@ -311,7 +327,9 @@ ExecReadyInterpretedExpr(ExprState *state)
 			return;
 		}
 		else if (step0 == EEOP_CASE_TESTVAL &&
-				 step1 == EEOP_FUNCEXPR_STRICT &&
+				 (step1 == EEOP_FUNCEXPR_STRICT ||
+				  step1 == EEOP_FUNCEXPR_STRICT_1 ||
+				  step1 == EEOP_FUNCEXPR_STRICT_2) &&
 				 state->steps[0].d.casetest.value)
 		{
 			state->evalfunc_private = (void *) ExecJustApplyFuncToCase;
@@ -421,8 +439,22 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 		&&CASE_EEOP_CONST,
 		&&CASE_EEOP_FUNCEXPR,
 		&&CASE_EEOP_FUNCEXPR_STRICT,
+		&&CASE_EEOP_FUNCEXPR_STRICT_1,
+		&&CASE_EEOP_FUNCEXPR_STRICT_2,
 		&&CASE_EEOP_FUNCEXPR_FUSAGE,
 		&&CASE_EEOP_FUNCEXPR_STRICT_FUSAGE,
+		&&CASE_EEOP_INT4_EQ,
+		&&CASE_EEOP_INT4_NE,
+		&&CASE_EEOP_INT4_LT,
+		&&CASE_EEOP_INT4_LE,
+		&&CASE_EEOP_INT4_GT,
+		&&CASE_EEOP_INT4_GE,
+		&&CASE_EEOP_INT8_EQ,
+		&&CASE_EEOP_INT8_NE,
+		&&CASE_EEOP_INT8_LT,
+		&&CASE_EEOP_INT8_LE,
+		&&CASE_EEOP_INT8_GT,
+		&&CASE_EEOP_INT8_GE,
 		&&CASE_EEOP_BOOL_AND_STEP_FIRST,
 		&&CASE_EEOP_BOOL_AND_STEP,
 		&&CASE_EEOP_BOOL_AND_STEP_LAST,
@@ -756,6 +788,52 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			EEO_NEXT();
 		}
 
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_1)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo_data;
+			NullableDatum *args = fcinfo->args;
+
+			Assert(op->d.func.nargs == 1);
+
+			/* strict function, so check for NULL args */
+			if (args[0].isnull)
+				*op->resnull = true;
+			else
+			{
+				Datum		d;
+
+				fcinfo->isnull = false;
+				d = op->d.func.fn_addr(fcinfo);
+				*op->resvalue = d;
+				*op->resnull = fcinfo->isnull;
+			}
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_FUNCEXPR_STRICT_2)
+		{
+			FunctionCallInfo fcinfo = op->d.func.fcinfo_data;
+			NullableDatum *args = fcinfo->args;
+
+			Assert(op->d.func.nargs == 2);
+
+			/* strict function, so check for NULL args */
+			if (args[0].isnull || args[1].isnull)
+				*op->resnull = true;
+			else
+			{
+				Datum		d;
+
+				fcinfo->isnull = false;
+				d = op->d.func.fn_addr(fcinfo);
+				*op->resvalue = d;
+				*op->resnull = fcinfo->isnull;
+			}
+
+			EEO_NEXT();
+		}
+
 		EEO_CASE(EEOP_FUNCEXPR_FUSAGE)
 		{
 			/* not common enough to inline */
@@ -772,6 +850,118 @@ ExecInterpExpr(ExprState *state, ExprContext *econtext, bool *isnull)
 			EEO_NEXT();
 		}
 
+		/*
+		 * Inlined int4 and int8 comparisons.  These are strict, so a NULL
+		 * argument yields NULL.
+		 */
+		EEO_CASE(EEOP_INT4_EQ)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, ==);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT4_NE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, !=);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT4_LT)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, <);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT4_LE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, <=);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT4_GT)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, >);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT4_GE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt32, >=);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_EQ)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, ==);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_NE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, !=);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_LT)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, <);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_LE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, <=);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_GT)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, >);
+
+			EEO_NEXT();
+		}
+
+		EEO_CASE(EEOP_INT8_GE)
+		{
+			NullableDatum *args = op->d.func.fcinfo_data->args;
+
+			EEO_INLINE_COMPARE(args, DatumGetInt64, >=);
+
+			EEO_NEXT();
+		}
+
 		/*
 		 * If any of its clauses is FALSE, an AND's result is FALSE regardless
 		 * of the states of the rest of the clauses, so we can stop evaluating
@@ -380,6 +380,27 @@ LookupTupleHashEntryHash(TupleHashTable hashtable, TupleTableSlot *slot,
 	return entry;
 }
 
+/*
+ * Prefetch what a lookup with the given hash value is going to read first.
+ * This is for callers that compute the hash values of a group of tuples
+ * before looking any of them up, so that the cache misses of the lookups
+ * can overlap.  Without fetch_tuple, the bucket the lookup starts at is
+ * prefetched.  With it, the tuple stored in that bucket is, if its hash
+ * value matches; that reads the bucket, so it's only worth doing once the
+ * bucket itself has been prefetched.
+ */
+void
+TupleHashTablePrefetch(TupleHashTable hashtable, uint32 hash, bool fetch_tuple)
+{
+	tuplehash_hash *tb = hashtable->hashtab;
+	TupleHashEntry entry = &tb->data[hash & tb->sizemask];
+
+	if (!fetch_tuple)
+		pg_prefetch_mem(entry);
+	else if (entry->status == tuplehash_SH_IN_USE && entry->hash == hash)
+		pg_prefetch_mem(entry->firstTuple);
+}
+
 /*
  * Search for a hashtable entry matching the given tuple.  No entry is
  * created if there's not a match.  This is similar to the non-creating
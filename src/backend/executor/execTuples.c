@@ -63,6 +63,7 @@
 #include "catalog/pg_type.h"
 #include "funcapi.h"
 #include "nodes/nodeFuncs.h"
+#include "port/pg_bitutils.h"
 #include "storage/bufmgr.h"
 #include "utils/builtins.h"
 #include "utils/expandeddatum.h"
@@ -907,6 +908,38 @@ tts_buffer_heap_store_tuple(TupleTableSlot *slot, HeapTuple tuple,
 	}
 }
 
+/*
+ * first_null_attr
+ *		Return the 0-based number of the first attribute below natts that is
+ *		marked NULL in the tuple's null bitmap, or natts if there is none.
+ *
+ * Whole bitmap bytes are tested at once, so this is cheap for wide tuples
+ * where the leading columns are all non-NULL.
+ */
+static inline int
+first_null_attr(const bits8 *bits, int natts)
+{
+	int			nbytes = natts >> 3;
+	int			remaining = natts & 7;
+	int			i;
+
+	for (i = 0; i < nbytes; i++)
+	{
+		if (bits[i] != 0xFF)
+			return i * 8 + pg_rightmost_one_pos32(~bits[i] & 0xFF);
+	}
+
+	if (remaining > 0)
+	{
+		uint32		nullbits = ~bits[nbytes] & ((1 << remaining) - 1);
+
+		if (nullbits != 0)
+			return nbytes * 8 + pg_rightmost_one_pos32(nullbits);
+	}
+
+	return natts;
+}
+
 /*
  * slot_deform_heap_tuple
  *		Given a TupleTableSlot, extract data from the slot's physical tuple
@@ -959,6 +992,34 @@ slot_deform_heap_tuple(TupleTableSlot *slot, HeapTuple tuple, uint32 *offp,
 
 	tp = (char *) tup + tup->t_hoff;
 
+	/*
+	 * Fast path for the leading fixed-width attributes whose offsets are
+	 * already cached in the tuple descriptor.  As long as none of them is
+	 * NULL, they can be fetched directly without the alignment and NULL
+	 * handling of the general loop below.  That loop then continues with the
+	 * first attribute not covered here, with the same state it would have
+	 * reached on its own.
+	 */
+	if (attnum == 0)
+	{
+		int			fastnatts = natts;
+
+		if (hasnulls)
+			fastnatts = first_null_attr(bp, natts);
+
+		for (; attnum < fastnatts; attnum++)
+		{
+			Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum);
+
+			if (thisatt->attcacheoff < 0 || thisatt->attlen <= 0)
+				break;
+
+			values[attnum] = fetchatt(thisatt, tp + thisatt->attcacheoff);
+			isnull[attnum] = false;
+			off = thisatt->attcacheoff + thisatt->attlen;
+		}
+	}
+
 	for (; attnum < natts; attnum++)
 	{
 		Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum);
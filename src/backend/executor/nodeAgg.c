@@ -314,6 +314,14 @@
  */
 #define HASHAGG_HLL_BIT_WIDTH 5
 
+/*
+ * Once a single hash table holds this many groups, it's unlikely to stay in
+ * cache, and agg_fill_hash_table() reads its input HASHAGG_PREFETCH_TUPLES
+ * at a time so that the cache misses of their lookups can overlap.
+ */
+#define HASHAGG_PREFETCH_MIN_GROUPS 65536
+#define HASHAGG_PREFETCH_TUPLES 16
+
 /*
  * Estimate chunk overhead as a constant 16 bytes. XXX: should this be
  * improved?
@@ -351,6 +359,8 @@ typedef struct HashAggSpill
 typedef struct HashAggBatch
 {
 	int			setno;			/* grouping set */
+	int			depth;			/* 1 for partitions of the input, 2 for
+								 * partitions of those, and so on */
 	int			used_bits;		/* number of bits of hash already used */
 	LogicalTape *input_tape;	/* input partition tape */
 	int64		input_tuples;	/* number of tuples in this batch */
@@ -416,9 +426,10 @@ static int	hash_choose_num_partitions(double input_groups,
 static void initialize_hash_entry(AggState *aggstate,
 								  TupleHashTable hashtable,
 								  TupleHashEntry entry);
-static void lookup_hash_entries(AggState *aggstate);
+static void lookup_hash_entries(AggState *aggstate, uint32 *hashes);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
+static int	agg_prefetch_hash_input(AggState *aggstate);
 static bool agg_refill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table_in_memory(AggState *aggstate);
@@ -429,8 +440,8 @@ static void hash_agg_update_metrics(AggState *aggstate, bool from_tape,
 static void hashagg_finish_initial_spills(AggState *aggstate);
 static void hashagg_reset_spill_state(AggState *aggstate);
 static HashAggBatch *hashagg_batch_new(LogicalTape *input_tape, int setno,
-									   int64 input_tuples, double input_card,
-									   int used_bits);
+									   int depth, int64 input_tuples,
+									   double input_card, int used_bits);
 static MinimalTuple hashagg_batch_read(HashAggBatch *batch, uint32 *hashp);
 static void hashagg_spill_init(HashAggSpill *spill, LogicalTapeSet *lts,
 							   int used_bits, double input_groups,
@@ -438,7 +449,7 @@ static void hashagg_spill_init(HashAggSpill *spill, LogicalTapeSet *lts,
 static Size hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
 								TupleTableSlot *slot, uint32 hash);
 static void hashagg_spill_finish(AggState *aggstate, HashAggSpill *spill,
-								 int setno);
+								 int setno, int depth);
 static Datum GetAggInitVal(Datum textInitVal, Oid transtype);
 static void build_pertrans_for_aggref(AggStatePerTrans pertrans,
 									  AggState *aggstate, EState *estate,
@@ -1851,7 +1862,17 @@ hash_agg_check_limits(AggState *aggstate)
 		(meta_mem + hashkey_mem > aggstate->hash_mem_limit ||
 		 ngroups > aggstate->hash_ngroups_limit))
 	{
-		hash_agg_enter_spill_mode(aggstate);
+		/*
+		 * The output of a partial aggregate is combined by a Finalize
+		 * Aggregate anyway, so the same group may be emitted more than once.
+		 * Rather than spill, just emit what we have and start over with an
+		 * empty table; see agg_retrieve_hash_table().
+		 */
+		if (DO_AGGSPLIT_SKIPFINAL(aggstate->aggsplit) &&
+			aggstate->aggstrategy == AGG_HASHED)
+			aggstate->hash_flush_pending = true;
+		else
+			hash_agg_enter_spill_mode(aggstate);
 	}
 }
 
@@ -2058,6 +2079,8 @@ initialize_hash_entry(AggState *aggstate, TupleHashTable hashtable,
 
 /*
  * Look up hash entries for the current tuple in all hashed grouping sets.
+ * If hashes isn't NULL, it holds the tuple's hash value for each set,
+ * computed earlier.
  *
  * Be aware that lookup_hash_entry can reset the tmpcontext.
  *
@@ -2074,7 +2097,7 @@ initialize_hash_entry(AggState *aggstate, TupleHashTable hashtable,
  * efficient.
  */
 static void
-lookup_hash_entries(AggState *aggstate)
+lookup_hash_entries(AggState *aggstate, uint32 *hashes)
 {
 	AggStatePerGroup *pergroup = aggstate->hash_pergroup;
 	TupleTableSlot *outerslot = aggstate->tmpcontext->ecxt_outertuple;
@@ -2098,8 +2121,15 @@ lookup_hash_entries(AggState *aggstate)
 						  outerslot,
 						  hashslot);
 
-		entry = LookupTupleHashEntry(hashtable, hashslot,
-									 p_isnew, &hash);
+		if (hashes != NULL)
+		{
+			hash = hashes[setno];
+			entry = LookupTupleHashEntryHash(hashtable, hashslot,
+											 p_isnew, hash);
+		}
+		else
+			entry = LookupTupleHashEntry(hashtable, hashslot,
+										 p_isnew, &hash);
 
 		if (entry != NULL)
 		{
@@ -2429,7 +2459,7 @@ agg_retrieve_direct(AggState *aggstate)
 					if (aggstate->aggstrategy == AGG_MIXED &&
 						aggstate->current_phase == 1)
 					{
-						lookup_hash_entries(aggstate);
+						lookup_hash_entries(aggstate, NULL);
 					}
 
 					/* Advance the aggregates (or combine functions) */
@@ -2530,6 +2560,34 @@ agg_fill_hash_table(AggState *aggstate)
 	 */
 	for (;;)
 	{
+		/* Stop if a partial aggregate must emit its groups early */
+		if (aggstate->hash_flush_pending)
+			break;
+
+		/*
+		 * Once the hash table has grown large, read ahead a group of input
+		 * tuples and prefetch their buckets before looking them up.
+		 */
+		if (aggstate->hash_prefetch_slots != NULL &&
+			aggstate->hash_ngroups_current >= HASHAGG_PREFETCH_MIN_GROUPS)
+		{
+			int			ntuples = agg_prefetch_hash_input(aggstate);
+			int			i;
+
+			if (ntuples == 0)
+				break;
+
+			for (i = 0; i < ntuples; i++)
+			{
+				tmpcontext->ecxt_outertuple = aggstate->hash_prefetch_slots[i];
+				lookup_hash_entries(aggstate,
+									&aggstate->hash_prefetch_hashes[i]);
+				advance_aggregates(aggstate);
+				ResetExprContext(aggstate->tmpcontext);
+			}
+			continue;
+		}
+
 		outerslot = fetch_input_tuple(aggstate);
 		if (TupIsNull(outerslot))
 			break;
@@ -2538,7 +2596,7 @@ agg_fill_hash_table(AggState *aggstate)
 		tmpcontext->ecxt_outertuple = outerslot;
 
 		/* Find or build hashtable entries */
-		lookup_hash_entries(aggstate);
+		lookup_hash_entries(aggstate, NULL);
 
 		/* Advance the aggregates (or combine functions) */
 		advance_aggregates(aggstate);
@@ -2560,6 +2618,55 @@ agg_fill_hash_table(AggState *aggstate)
 						   &aggstate->perhash[0].hashiter);
 }
 
+/*
+ * Read up to HASHAGG_PREFETCH_TUPLES input tuples for agg_fill_hash_table,
+ * compute their hash values, and prefetch the hash table buckets and group
+ * tuples their lookups will need.  A lookup in a hash table that doesn't fit
+ * in cache takes two dependent cache misses; issuing the prefetches for a
+ * whole group of tuples up front lets those of different tuples overlap.
+ *
+ * Only used with a single hash table.  The input tuples are copied, since
+ * the outer plan overwrites its slot on every call; the copies are of the
+ * same kind of slot, as our compiled expressions may depend on it.
+ *
+ * Returns the number of tuples read; zero at the end of the input.
+ */
+static int
+agg_prefetch_hash_input(AggState *aggstate)
+{
+	AggStatePerHash perhash = &aggstate->perhash[0];
+	TupleHashTable hashtable = perhash->hashtable;
+	uint32	   *hashes = aggstate->hash_prefetch_hashes;
+	int			ntuples;
+	int			i;
+
+	Assert(aggstate->num_hashes == 1);
+
+	for (ntuples = 0; ntuples < HASHAGG_PREFETCH_TUPLES; ntuples++)
+	{
+		TupleTableSlot *outerslot = fetch_input_tuple(aggstate);
+		TupleTableSlot *slot = aggstate->hash_prefetch_slots[ntuples];
+
+		if (TupIsNull(outerslot))
+			break;
+
+		ExecCopySlot(slot, outerslot);
+		prepare_hash_slot(perhash, slot, perhash->hashslot);
+		hashes[ntuples] = TupleHashTableHash(hashtable, perhash->hashslot);
+		TupleHashTablePrefetch(hashtable, hashes[ntuples], false);
+	}
+
+	/* The buckets should be arriving by now; go for the group tuples */
+	for (i = 0; i < ntuples; i++)
+		TupleHashTablePrefetch(hashtable, hashes[i], true);
+
+	/* At the end of the input, don't hold on to buffer pins of old copies */
+	for (i = ntuples; i < HASHAGG_PREFETCH_TUPLES; i++)
+		ExecClearTuple(aggstate->hash_prefetch_slots[i]);
+
+	return ntuples;
+}
+
 /*
  * If any data was spilled during hash aggregation, reset the hash table and
  * reprocess one batch of spilled data. After reprocessing a batch, the hash
@@ -2699,7 +2806,8 @@ agg_refill_hash_table(AggState *aggstate)
 
 	if (spill_initialized)
 	{
-		hashagg_spill_finish(aggstate, &spill, batch->setno);
+		hashagg_spill_finish(aggstate, &spill, batch->setno,
+							 batch->depth + 1);
 		hash_agg_update_metrics(aggstate, true, spill.npartitions);
 	}
 	else
@@ -2721,8 +2829,9 @@ agg_refill_hash_table(AggState *aggstate)
  * ExecAgg for hashed case: retrieving groups from hash table
  *
  * After exhausting in-memory tuples, also try refilling the hash table using
- * previously-spilled tuples. Only returns NULL after all in-memory and
- * spilled tuples are exhausted.
+ * previously-spilled tuples, or for a partial aggregate that emitted its
+ * groups early, the rest of the input. Only returns NULL after all in-memory
+ * and spilled tuples are exhausted.
  */
 static TupleTableSlot *
 agg_retrieve_hash_table(AggState *aggstate)
@@ -2734,6 +2843,25 @@ agg_retrieve_hash_table(AggState *aggstate)
 		result = agg_retrieve_hash_table_in_memory(aggstate);
 		if (result == NULL)
 		{
+			/*
+			 * If the table was emitted early, empty it and go on reading the
+			 * input.  Nothing was spilled in that case.
+			 */
+			if (aggstate->hash_flush_pending)
+			{
+				Assert(!aggstate->hash_ever_spilled);
+
+				aggstate->hash_flush_pending = false;
+				aggstate->hash_flushes++;
+
+				ReScanExprContext(aggstate->hashcontext);
+				ResetTupleHashTable(aggstate->perhash[0].hashtable);
+				aggstate->hash_ngroups_current = 0;
+
+				agg_fill_hash_table(aggstate);
+				continue;
+			}
+
 			if (!agg_refill_hash_table(aggstate))
 			{
 				aggstate->agg_done = true;
@@ -2970,12 +3098,13 @@ hashagg_spill_tuple(AggState *aggstate, HashAggSpill *spill,
  * be done.
  */
 static HashAggBatch *
-hashagg_batch_new(LogicalTape *input_tape, int setno,
+hashagg_batch_new(LogicalTape *input_tape, int setno, int depth,
 				  int64 input_tuples, double input_card, int used_bits)
 {
 	HashAggBatch *batch = palloc0(sizeof(HashAggBatch));
 
 	batch->setno = setno;
+	batch->depth = depth;
 	batch->used_bits = used_bits;
 	batch->input_tape = input_tape;
 	batch->input_tuples = input_tuples;
@@ -3050,7 +3179,7 @@ hashagg_finish_initial_spills(AggState *aggstate)
 			HashAggSpill *spill = &aggstate->hash_spills[setno];
 
 			total_npartitions += spill->npartitions;
-			hashagg_spill_finish(aggstate, spill, setno);
+			hashagg_spill_finish(aggstate, spill, setno, 1);
 		}
 
 		/*
@@ -3069,10 +3198,11 @@ hashagg_finish_initial_spills(AggState *aggstate)
 /*
  * hashagg_spill_finish
  *
- * Transform spill partitions into new batches.
+ * Transform spill partitions into new batches, at the given recursion depth.
  */
 static void
-hashagg_spill_finish(AggState *aggstate, HashAggSpill *spill, int setno)
+hashagg_spill_finish(AggState *aggstate, HashAggSpill *spill, int setno,
+					 int depth)
 {
 	int			i;
 	int			used_bits = 32 - spill->shift;
@@ -3096,11 +3226,20 @@ hashagg_spill_finish(AggState *aggstate, HashAggSpill *spill, int setno)
 		/* rewinding frees the buffer while not in use */
 		LogicalTapeRewindForRead(tape, HASHAGG_READ_BUFFER_SIZE);
 
-		new_batch = hashagg_batch_new(tape, setno,
+		new_batch = hashagg_batch_new(tape, setno, depth,
 									  spill->ntuples[i], cardinality,
 									  used_bits);
 		aggstate->hash_batches = lappend(aggstate->hash_batches, new_batch);
 		aggstate->hash_batches_used++;
+
+		/* track the shape of the spill for EXPLAIN ANALYZE */
+		aggstate->hash_spill_depth = Max(aggstate->hash_spill_depth, depth);
+		if (aggstate->hash_spilled_tuples == 0 ||
+			spill->ntuples[i] < aggstate->hash_smallest_batch)
+			aggstate->hash_smallest_batch = spill->ntuples[i];
+		aggstate->hash_largest_batch = Max(aggstate->hash_largest_batch,
+										   spill->ntuples[i]);
+		aggstate->hash_spilled_tuples += spill->ntuples[i];
 	}
 
 	pfree(spill->ntuples);
@@ -3603,6 +3742,19 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 		/* Initialize this to 1, meaning nothing spilled, yet */
 		aggstate->hash_batches_used = 1;
+
+		/* Reading ahead is only done for a single hash table */
+		if (node->aggstrategy == AGG_HASHED && aggstate->num_hashes == 1)
+		{
+			aggstate->hash_prefetch_slots = (TupleTableSlot **)
+				palloc(HASHAGG_PREFETCH_TUPLES * sizeof(TupleTableSlot *));
+			for (i = 0; i < HASHAGG_PREFETCH_TUPLES; i++)
+				aggstate->hash_prefetch_slots[i] =
+					ExecInitExtraTupleSlot(estate, scanDesc,
+										   aggstate->ss.ps.outerops);
+			aggstate->hash_prefetch_hashes = (uint32 *)
+				palloc(HASHAGG_PREFETCH_TUPLES * sizeof(uint32));
+		}
 	}
 
 	/*
@@ -4286,7 +4438,12 @@ ExecEndAgg(AggState *node)
 		Assert(ParallelWorkerNumber <= node->shared_info->num_workers);
 		si = &node->shared_info->sinstrument[ParallelWorkerNumber];
 		si->hash_batches_used = node->hash_batches_used;
+		si->hash_flushes = node->hash_flushes;
 		si->hash_disk_used = node->hash_disk_used;
+		si->hash_spill_depth = node->hash_spill_depth;
+		si->hash_smallest_batch = node->hash_smallest_batch;
+		si->hash_largest_batch = node->hash_largest_batch;
+		si->hash_spilled_tuples = node->hash_spilled_tuples;
 		si->hash_mem_peak = node->hash_mem_peak;
 	}
 
@@ -4360,13 +4517,14 @@ ExecReScanAgg(AggState *node)
 			return;
 
 		/*
-		 * If we do have the hash table, and it never spilled, and the subplan
-		 * does not have any parameter changes, and none of our own parameter
-		 * changes affect input expressions of the aggregated functions, then
-		 * we can just rescan the existing hash table; no need to build it
-		 * again.
+		 * If we do have the hash table, and it never spilled or was emitted
+		 * early, and the subplan does not have any parameter changes, and
+		 * none of our own parameter changes affect input expressions of the
+		 * aggregated functions, then we can just rescan the existing hash
+		 * table; no need to build it again.
 		 */
 		if (outerPlan->chgParam == NULL && !node->hash_ever_spilled &&
+			node->hash_flushes == 0 && !node->hash_flush_pending &&
 			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams))
 		{
 			ResetTupleHashIterator(node->perhash[0].hashtable,
@@ -4427,6 +4585,7 @@ ExecReScanAgg(AggState *node)
 
 		node->hash_ever_spilled = false;
 		node->hash_spill_mode = false;
+		node->hash_flush_pending = false;
 		node->hash_ngroups_current = 0;
 
 		ReScanExprContext(node->hashcontext);
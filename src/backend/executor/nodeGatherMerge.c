@@ -247,8 +247,18 @@ ExecGatherMerge(PlanState *pstate)
 			}
 		}
 
-		/* allow leader to participate if enabled or no choice */
-		if (parallel_leader_participation || node->nreaders == 0)
+		/*
+		 * Allow leader to participate if enabled or no choice.  Unlike
+		 * Gather's leader, which goes back to reading the tuple queues
+		 * between the tuples it produces itself, ours must run a local Sort
+		 * over its whole share before it can merge anything, and meanwhile
+		 * the workers stall on full queues.  parallel_leader_merge_only_workers
+		 * can therefore leave the leader to merging once enough workers run.
+		 */
+		if (node->nreaders == 0 ||
+			(parallel_leader_participation &&
+			 (parallel_leader_merge_only_workers == 0 ||
+			  node->nreaders < parallel_leader_merge_only_workers)))
 			node->need_to_scan_locally = true;
 		node->initialized = true;
 	}
@@ -188,6 +188,11 @@ MultiExecPrivateHash(HashState *node)
 				ExecHashTableInsert(hashtable, slot, hashvalue);
 			}
 			hashtable->totalTuples += 1;
+
+			if (hashtable->runtimeFilter)
+				bloom_add_element(hashtable->runtimeFilter,
+								  (unsigned char *) &hashvalue,
+								  sizeof(hashvalue));
 		}
 	}
 
@@ -200,6 +205,9 @@ MultiExecPrivateHash(HashState *node)
 	if (hashtable->spaceUsed > hashtable->spacePeak)
 		hashtable->spacePeak = hashtable->spaceUsed;
 
+	/* The table is complete, so we can summarize its buckets */
+	ExecHashBuildBucketTags(hashtable);
+
 	hashtable->partialTuples = hashtable->totalTuples;
 }
 
@@ -486,6 +494,8 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 	hashtable->log2_nbuckets = log2_nbuckets;
 	hashtable->log2_nbuckets_optimal = log2_nbuckets;
 	hashtable->buckets.unshared = NULL;
+	hashtable->bucketTags = NULL;
+	hashtable->runtimeFilter = NULL;
 	hashtable->keepNulls = keepNulls;
 	hashtable->skewEnabled = false;
 	hashtable->skewBucket = NULL;
@@ -508,6 +518,7 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 	hashtable->spaceUsedSkew = 0;
 	hashtable->spaceAllowedSkew =
 		hashtable->spaceAllowed * SKEW_HASH_MEM_PERCENT / 100;
+	hashtable->spaceRuntimeFilter = 0;
 	hashtable->chunks = NULL;
 	hashtable->current_chunk = NULL;
 	hashtable->parallel_state = state->parallel_state;
@@ -1470,6 +1481,7 @@ ExecHashIncreaseNumBuckets(HashJoinTable hashtable)
 	Assert(hashtable->nbuckets > 1);
 	Assert(hashtable->nbuckets <= (INT_MAX / 2));
 	Assert(hashtable->nbuckets == (1 << hashtable->log2_nbuckets));
+	Assert(hashtable->bucketTags == NULL);
 
 	/*
 	 * Just reallocate the proper number of buckets - we don't need to walk
@@ -1971,7 +1983,18 @@ ExecScanHashBucket(HashJoinState *hjstate,
 	else if (hjstate->hj_CurSkewBucketNo != INVALID_SKEW_BUCKET_NO)
 		hashTuple = hashtable->skewBucket[hjstate->hj_CurSkewBucketNo]->tuples;
 	else
+	{
+		/*
+		 * If the bucket's tag shows that none of its tuples can have this
+		 * hash value, there's no need to look at the bucket at all.
+		 */
+		if (hashtable->bucketTags != NULL &&
+			(hashtable->bucketTags[hjstate->hj_CurBucketNo] &
+			 HJ_BUCKET_TAG(hashvalue)) == 0)
+			return false;
+
 		hashTuple = hashtable->buckets.unshared[hjstate->hj_CurBucketNo];
+	}
 
 	while (hashTuple != NULL)
 	{
@@ -2174,6 +2197,9 @@ ExecHashTableReset(HashJoinTable hashtable)
 	hashtable->buckets.unshared = (HashJoinTuple *)
 		palloc0(nbuckets * sizeof(HashJoinTuple));
 
+	/* The tags were freed along with the batch, and must be rebuilt later */
+	hashtable->bucketTags = NULL;
+
 	hashtable->spaceUsed = 0;
 
 	MemoryContextSwitchTo(oldcxt);
@@ -2182,6 +2208,113 @@ ExecHashTableReset(HashJoinTable hashtable)
 	hashtable->chunks = NULL;
 }
 
+/*
+ * ExecHashBuildBucketTags
+ *		summarize the hash values in each bucket of the current batch
+ *
+ * This must be called once all tuples of the batch have been loaded into a
+ * non-shared hash table, and before probing it; the table doesn't change
+ * while it's being probed.  Tags are computed from the dense tuple storage,
+ * which can be read sequentially, rather than by following bucket chains.
+ * Tuples in skew buckets are not covered, since those are probed separately.
+ *
+ * Does nothing if the table is too small for the tags to be worthwhile.
+ */
+void
+ExecHashBuildBucketTags(HashJoinTable hashtable)
+{
+	HashMemoryChunk chunk;
+	uint8	   *tags;
+
+	Assert(hashtable->parallel_state == NULL);
+
+	hashtable->bucketTags = NULL;
+	if (hashtable->nbuckets < HJ_BUCKET_TAGS_MIN_BUCKETS)
+		return;
+
+	tags = (uint8 *) MemoryContextAllocZero(hashtable->batchCxt,
+											hashtable->nbuckets);
+
+	for (chunk = hashtable->chunks; chunk != NULL; chunk = chunk->next.unshared)
+	{
+		size_t		idx = 0;
+
+		while (idx < chunk->used)
+		{
+			HashJoinTuple hashTuple = (HashJoinTuple) (HASH_CHUNK_DATA(chunk) + idx);
+			uint32		hashvalue = hashTuple->hashvalue;
+
+			tags[hashvalue & (hashtable->nbuckets - 1)] |=
+				HJ_BUCKET_TAG(hashvalue);
+
+			/* advance index past the tuple */
+			idx += MAXALIGN(HJTUPLE_OVERHEAD +
+							HJTUPLE_MINTUPLE(hashTuple)->t_len);
+		}
+	}
+
+	hashtable->bucketTags = tags;
+
+	/* Account for the tags in spaceUsed, like the buckets */
+	hashtable->spaceUsed += hashtable->nbuckets;
+	if (hashtable->spaceUsed > hashtable->spacePeak)
+		hashtable->spacePeak = hashtable->spaceUsed;
+}
+
+/*
+ * ExecHashTableInitRuntimeFilter
+ *		set up a Bloom filter of the hash values of all inner tuples
+ *
+ * Must be called before the table is filled by MultiExecPrivateHash, which
+ * adds every tuple it hashes to the filter, whichever batch it belongs to.
+ * The filter therefore remains valid for the whole join, and an outer tuple
+ * whose hash value it lacks cannot have a join partner.  ntuples and
+ * tupwidth are the planner's estimates of the number and width of the inner
+ * tuples.
+ *
+ * The filter comes out of the same hash_mem budget as the table itself: it
+ * is only created if it fits next to the expected single batch of inner
+ * tuples, and spaceAllowed is reduced by its size.
+ */
+void
+ExecHashTableInitRuntimeFilter(HashJoinTable hashtable, double ntuples,
+							   int tupwidth)
+{
+	MemoryContext oldcxt;
+	double		inner_bytes;
+	double		filter_kb;
+
+	Assert(hashtable->parallel_state == NULL);
+	Assert(hashtable->totalTuples == 0);
+
+	/* no filter if the inner side isn't expected to fit in memory */
+	if (hashtable->nbatch > 1)
+		return;
+
+	ntuples = Max(ntuples, 1.0);
+	inner_bytes = ntuples * (HJTUPLE_OVERHEAD +
+							 MAXALIGN(SizeofMinimalTupleHeader) +
+							 MAXALIGN(tupwidth)) +
+		hashtable->nbuckets * sizeof(HashJoinTuple);
+	filter_kb = ((double) hashtable->spaceAllowed - inner_bytes) / 1024.0;
+
+	/* bloom_create() never makes a filter smaller than 1MB */
+	if (filter_kb < 1024.0)
+		return;
+	filter_kb = Min(filter_kb, MAX_KILOBYTES);
+
+	oldcxt = MemoryContextSwitchTo(hashtable->hashCxt);
+	hashtable->runtimeFilter = bloom_create((int64) ntuples,
+											(int) filter_kb, 0);
+	MemoryContextSwitchTo(oldcxt);
+
+	/* account for the filter like the rest of the table */
+	hashtable->spaceRuntimeFilter =
+		GetMemoryChunkSpace(hashtable->runtimeFilter);
+	hashtable->spaceAllowed -= Min(hashtable->spaceRuntimeFilter,
+								   hashtable->spaceAllowed);
+}
+
 /*
  * ExecHashTableResetMatchFlags
  *		Clear all the HeapTupleHeaderHasMatch flags in the table
@@ -2720,7 +2853,8 @@ ExecHashAccumInstrumentation(HashInstrumentation *instrument,
 	instrument->nbatch_original = Max(instrument->nbatch_original,
 									  hashtable->nbatch_original);
 	instrument->space_peak = Max(instrument->space_peak,
-								 hashtable->spacePeak);
+								 hashtable->spacePeak +
+								 hashtable->spaceRuntimeFilter);
 }
 
 /*
@@ -112,7 +112,9 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "executor/nodeSeqscan.h"
 #include "miscadmin.h"
+#include "optimizer/optimizer.h"
 #include "pgstat.h"
 #include "utils/memutils.h"
 #include "utils/sharedtuplestore.h"
@@ -133,6 +135,23 @@
 /* Returns true if doing null-fill on inner relation */
 #define HJ_FILL_INNER(hjstate)	((hjstate)->hj_NullOuterTupleSlot != NULL)
 
+/*
+ * A runtime filter is only considered if the outer scan is expected to
+ * return at least this many rows.  Once in use, it's dropped again if it
+ * removes less than an eighth of the first HJ_RUNTIME_FILTER_TRIAL_TUPLES
+ * outer tuples.
+ */
+#define HJ_RUNTIME_FILTER_MIN_OUTER_ROWS	100000
+#define HJ_RUNTIME_FILTER_TRIAL_TUPLES		4096
+
+/*
+ * Once the current batch's hash table takes up this much memory, outer
+ * tuples are read HJ_PREFETCH_TUPLES at a time so that the cache misses of
+ * their probes can overlap; see ExecHashJoinPrefetchOuter().
+ */
+#define HJ_PREFETCH_MIN_SPACE	(4 * 1024 * 1024)
+#define HJ_PREFETCH_TUPLES		16
+
 static TupleTableSlot *ExecHashJoinOuterGetTuple(PlanState *outerNode,
 												 HashJoinState *hjstate,
 												 uint32 *hashvalue);
@@ -143,6 +162,9 @@ static TupleTableSlot *ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 												 BufFile *file,
 												 uint32 *hashvalue,
 												 TupleTableSlot *tupleSlot);
+static int	ExecHashJoinPrefetchOuter(PlanState *outerNode,
+									  HashJoinState *hjstate,
+									  BufFile *file);
 static bool ExecHashJoinNewBatch(HashJoinState *hjstate);
 static bool ExecParallelHashJoinNewBatch(HashJoinState *hjstate);
 static void ExecParallelHashJoinPartitionOuter(HashJoinState *node);
@@ -282,6 +304,16 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 												HJ_FILL_INNER(node));
 				node->hj_HashTable = hashtable;
 
+				/*
+				 * If the outer side can use a runtime filter, have the Hash
+				 * node collect the inner hash values into one while it
+				 * builds the table.
+				 */
+				if (!parallel && node->hj_RuntimeFilterContext != NULL)
+					ExecHashTableInitRuntimeFilter(hashtable,
+												   hashNode->ps.plan->plan_rows,
+												   hashNode->ps.plan->plan_width);
+
 				/*
 				 * Execute the Hash node, to build the hash table.  If using
 				 * Parallel Hash, then we'll try to help hashing unless we
@@ -311,6 +343,15 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 				 */
 				node->hj_OuterNotEmpty = false;
 
+				/* Let the outer scan start discarding hopeless tuples */
+				if (hashtable->runtimeFilter != NULL)
+				{
+					node->hj_RuntimeFilterChecked = 0;
+					node->hj_RuntimeFilterRemoved = 0;
+					ExecSeqScanSetRuntimeFilter((SeqScanState *) outerNode,
+												node);
+				}
+
 				if (parallel)
 				{
 					Barrier    *build_barrier;
@@ -745,6 +786,16 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 
 	hjstate->hj_OuterHashKeys = ExecInitExprList(node->hashkeys,
 												 (PlanState *) hjstate);
+
+	hjstate->hj_PrefetchSlots = (TupleTableSlot **)
+		palloc(HJ_PREFETCH_TUPLES * sizeof(TupleTableSlot *));
+	for (int i = 0; i < HJ_PREFETCH_TUPLES; i++)
+		hjstate->hj_PrefetchSlots[i] =
+			ExecInitExtraTupleSlot(estate, outerDesc, ops);
+	hjstate->hj_PrefetchHashValues = (uint32 *)
+		palloc(HJ_PREFETCH_TUPLES * sizeof(uint32));
+	hjstate->hj_PrefetchCount = 0;
+	hjstate->hj_PrefetchNext = 0;
 	hjstate->hj_HashOperators = node->hashoperators;
 	hjstate->hj_Collations = node->hashcollations;
 
@@ -752,6 +803,20 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	/*
+	 * If unmatched outer tuples are never emitted, a Bloom filter of the
+	 * inner hash values lets a plain SeqScan below us discard outer tuples
+	 * that can't have a join partner, before they're returned to us.  That's
+	 * only worth its setup cost if the outer side is large, and the outer
+	 * hash keys mustn't mind being evaluated twice per tuple.  Hash joins
+	 * that turn out to be parallel-aware never build the filter.
+	 */
+	if (!HJ_FILL_OUTER(hjstate) &&
+		IsA(outerPlanState(hjstate), SeqScanState) &&
+		outerNode->plan_rows >= HJ_RUNTIME_FILTER_MIN_OUTER_ROWS &&
+		!contain_volatile_functions((Node *) node->hashkeys))
+		hjstate->hj_RuntimeFilterContext = CreateExprContext(estate);
+
 	return hjstate;
 }
 
@@ -813,6 +878,30 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 	int			curbatch = hashtable->curbatch;
 	TupleTableSlot *slot;
 
+	/*
+	 * If the hash table is too big to stay in cache, read tuples ahead in
+	 * groups, and return them from there.
+	 */
+	if (hjstate->hj_PrefetchNext == hjstate->hj_PrefetchCount &&
+		hashtable->spaceUsed >= HJ_PREFETCH_MIN_SPACE &&
+		TupIsNull(hjstate->hj_FirstOuterTupleSlot) &&
+		curbatch < hashtable->nbatch)
+	{
+		BufFile    *file = NULL;
+
+		if (curbatch > 0)
+			file = hashtable->outerBatchFile[curbatch];
+		if (ExecHashJoinPrefetchOuter(outerNode, hjstate, file) == 0)
+			return NULL;		/* End of this batch */
+	}
+	if (hjstate->hj_PrefetchNext < hjstate->hj_PrefetchCount)
+	{
+		int			i = hjstate->hj_PrefetchNext++;
+
+		*hashvalue = hjstate->hj_PrefetchHashValues[i];
+		return hjstate->hj_PrefetchSlots[i];
+	}
+
 	if (curbatch == 0)			/* if it is the first pass */
 	{
 		/*
@@ -875,6 +964,111 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 	return NULL;
 }
 
+/*
+ * ExecHashJoinPrefetchOuter
+ *
+ *		read up to HJ_PREFETCH_TUPLES tuples of the current batch ahead of
+ *		time, from the outer plan in the first pass or else from the batch's
+ *		temp file, and prefetch the parts of the hash table they'll probe.
+ *
+ * Probing a hash table that doesn't fit in cache takes two dependent cache
+ * misses per tuple, for the bucket header and for the first tuple in its
+ * chain.  Working out the buckets of a group of tuples up front lets those
+ * misses overlap each other, instead of being taken one after another.
+ * ExecHashJoinOuterGetTuple then returns the tuples in their original
+ * order.  Tuples of the first pass have to be copied, since the outer plan
+ * overwrites its slot on every call; the slots they're copied into are of
+ * the same kind as the outer plan's, as our expressions may depend on it.
+ *
+ * Returns the number of tuples read; zero at the end of the batch.
+ */
+static int
+ExecHashJoinPrefetchOuter(PlanState *outerNode, HashJoinState *hjstate,
+						  BufFile *file)
+{
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	ExprContext *econtext = hjstate->js.ps.ps_ExprContext;
+	uint32	   *hashvalues = hjstate->hj_PrefetchHashValues;
+	int			bucketnos[HJ_PREFETCH_TUPLES];
+	int			n = 0;
+	int			i;
+
+	Assert(hashtable->parallel_state == NULL);
+
+	hjstate->hj_PrefetchCount = 0;
+	hjstate->hj_PrefetchNext = 0;
+
+	/* in outer-join cases, a later batch's file may not exist */
+	if (hashtable->curbatch > 0 && file == NULL)
+		return 0;
+
+	while (n < HJ_PREFETCH_TUPLES)
+	{
+		TupleTableSlot *slot = hjstate->hj_PrefetchSlots[n];
+		int			batchno;
+
+		if (hashtable->curbatch == 0)
+		{
+			TupleTableSlot *outerslot = ExecProcNode(outerNode);
+
+			if (TupIsNull(outerslot))
+				break;
+
+			/* discard tuples that can't match because of a NULL */
+			econtext->ecxt_outertuple = outerslot;
+			if (!ExecHashGetHashValue(hashtable, econtext,
+									  hjstate->hj_OuterHashKeys,
+									  true, /* outer tuple */
+									  HJ_FILL_OUTER(hjstate),
+									  &hashvalues[n]))
+				continue;
+
+			/* remember outer relation is not empty for possible rescan */
+			hjstate->hj_OuterNotEmpty = true;
+
+			ExecCopySlot(slot, outerslot);
+		}
+		else if (TupIsNull(ExecHashJoinGetSavedTuple(hjstate, file,
+													 &hashvalues[n], slot)))
+			break;
+
+		ExecHashGetBucketAndBatch(hashtable, hashvalues[n],
+								  &bucketnos[n], &batchno);
+		if (batchno == hashtable->curbatch)
+		{
+			if (hashtable->bucketTags != NULL)
+				pg_prefetch_mem(&hashtable->bucketTags[bucketnos[n]]);
+			pg_prefetch_mem(&hashtable->buckets.unshared[bucketnos[n]]);
+		}
+		else
+			bucketnos[n] = -1;
+		n++;
+	}
+
+	/*
+	 * The bucket headers should be arriving by now, so follow them to the
+	 * first tuple of each chain, unless the bucket's tag rules it out.
+	 */
+	for (i = 0; i < n; i++)
+	{
+		int			bucketno = bucketnos[i];
+
+		if (bucketno < 0 ||
+			(hashtable->bucketTags != NULL &&
+			 (hashtable->bucketTags[bucketno] &
+			  HJ_BUCKET_TAG(hashvalues[i])) == 0))
+			continue;
+		pg_prefetch_mem(hashtable->buckets.unshared[bucketno]);
+	}
+
+	/* At the end of the batch, don't hold on to buffer pins of old copies */
+	for (i = n; i < HJ_PREFETCH_TUPLES; i++)
+		ExecClearTuple(hjstate->hj_PrefetchSlots[i]);
+
+	hjstate->hj_PrefetchCount = n;
+	return n;
+}
+
 /*
  * ExecHashJoinOuterGetTuple variant for the parallel case.
  */
@@ -1065,6 +1259,9 @@ ExecHashJoinNewBatch(HashJoinState *hjstate)
 		hashtable->innerBatchFile[curbatch] = NULL;
 	}
 
+	/* The batch's hash table is complete, so summarize its buckets */
+	ExecHashBuildBucketTags(hashtable);
+
 	/*
 	 * Rewind outer batch file (if present), so that we can start reading it.
 	 */
@@ -1203,6 +1400,51 @@ ExecParallelHashJoinNewBatch(HashJoinState *hjstate)
 	return false;
 }
 
+/*
+ * ExecHashJoinRuntimeFilter
+ *		check an outer tuple against the join's runtime filter
+ *
+ * Called by the outer SeqScan for each tuple it's about to return, which
+ * is the same tuple we'd get from it.  Returns false if the tuple certainly
+ * has no join partner, so the scan can discard it; true if it might have.
+ * If the filter proves not to be selective enough to pay for the extra
+ * hashing, it's detached from the scan again.
+ */
+bool
+ExecHashJoinRuntimeFilter(HashJoinState *hjstate, TupleTableSlot *slot)
+{
+	HashJoinTable hashtable = hjstate->hj_HashTable;
+	ExprContext *econtext = hjstate->hj_RuntimeFilterContext;
+	uint32		hashvalue;
+	bool		result;
+
+	Assert(hashtable != NULL && hashtable->runtimeFilter != NULL);
+
+	ResetExprContext(econtext);
+	econtext->ecxt_outertuple = slot;
+
+	/* outer tuples with NULL keys can't match; we never null-fill them */
+	if (ExecHashGetHashValue(hashtable, econtext, hjstate->hj_OuterHashKeys,
+							 true, false, &hashvalue))
+		result = !bloom_lacks_element(hashtable->runtimeFilter,
+									  (unsigned char *) &hashvalue,
+									  sizeof(hashvalue));
+	else
+		result = false;
+
+	hjstate->hj_RuntimeFilterChecked++;
+	if (!result)
+		hjstate->hj_RuntimeFilterRemoved++;
+
+	if (hjstate->hj_RuntimeFilterChecked == HJ_RUNTIME_FILTER_TRIAL_TUPLES &&
+		hjstate->hj_RuntimeFilterRemoved < HJ_RUNTIME_FILTER_TRIAL_TUPLES / 8)
+		ExecSeqScanSetRuntimeFilter(castNode(SeqScanState,
+											 outerPlanState(hjstate)),
+									NULL);
+
+	return result;
+}
+
 /*
  * ExecHashJoinSaveTuple
  *		save a tuple to a batch file.
@@ -1342,6 +1584,12 @@ ExecReScanHashJoin(HashJoinState *node)
 			/* for safety, be sure to clear child plan node's pointer too */
 			hashNode->hashtable = NULL;
 
+			/* the outer scan mustn't keep using the old table's filter */
+			if (node->hj_HashTable->runtimeFilter != NULL)
+				ExecSeqScanSetRuntimeFilter(castNode(SeqScanState,
+													 outerPlanState(node)),
+											NULL);
+
 			ExecHashTableDestroy(node->hj_HashTable);
 			node->hj_HashTable = NULL;
 			node->hj_JoinState = HJ_BUILD_HASHTABLE;
@@ -1363,6 +1611,8 @@ ExecReScanHashJoin(HashJoinState *node)
 
 	node->hj_MatchedOuter = false;
 	node->hj_FirstOuterTupleSlot = NULL;
+	node->hj_PrefetchCount = 0;
+	node->hj_PrefetchNext = 0;
 
 	/*
 	 * if chgParam of subnode is not null then plan will be re-scanned by
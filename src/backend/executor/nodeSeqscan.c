@@ -19,6 +19,7 @@
  *		ExecInitSeqScan			creates and initializes a seqscan node.
  *		ExecEndSeqScan			releases any storage allocated.
  *		ExecReScanSeqScan		rescans the relation
+ *		ExecSeqScanSetRuntimeFilter	sets or clears a hash join's runtime filter
  *
  *		ExecSeqScanEstimate		estimates DSM space needed for parallel scan
  *		ExecSeqScanInitializeDSM initialize DSM for parallel scan
@@ -29,11 +30,15 @@
 
 #include "access/relscan.h"
 #include "access/tableam.h"
+#include "executor/execScan.h"
 #include "executor/execdebug.h"
+#include "executor/nodeHashjoin.h"
 #include "executor/nodeSeqscan.h"
+#include "optimizer/optimizer.h"
 #include "utils/rel.h"
 
 static TupleTableSlot *SeqNext(SeqScanState *node);
+static Bitmapset *SeqScanNeededColumns(SeqScan *node, Relation rel);
 
 /* ----------------------------------------------------------------
  *						Scan Support
@@ -71,6 +76,7 @@ SeqNext(SeqScanState *node)
 		scandesc = table_beginscan(node->ss.ss_currentRelation,
 								   estate->es_snapshot,
 								   0, NULL);
+		table_scan_set_column_projection(scandesc, node->proj_attrs);
 		node->ss.ss_currentScanDesc = scandesc;
 	}
 
@@ -82,6 +88,40 @@ SeqNext(SeqScanState *node)
 	return NULL;
 }
 
+/*
+ * SeqScanNeededColumns -- determine which columns of the scanned relation
+ * are referenced by the plan's target list and quals.
+ *
+ * A whole-row reference is expanded into all the relation's columns, so an
+ * empty result (NULL) means that no columns are needed at all.
+ */
+static Bitmapset *
+SeqScanNeededColumns(SeqScan *node, Relation rel)
+{
+	Index		scanrelid = node->scan.scanrelid;
+	Bitmapset  *attrs = NULL;
+
+	pull_varattnos((Node *) node->scan.plan.targetlist, scanrelid, &attrs);
+	pull_varattnos((Node *) node->scan.plan.qual, scanrelid, &attrs);
+
+	if (bms_is_member(InvalidAttrNumber - FirstLowInvalidHeapAttributeNumber,
+					  attrs))
+	{
+		TupleDesc	tupdesc = RelationGetDescr(rel);
+
+		attrs = bms_del_member(attrs,
+							   InvalidAttrNumber - FirstLowInvalidHeapAttributeNumber);
+		for (int i = 0; i < tupdesc->natts; i++)
+		{
+			if (!TupleDescAttr(tupdesc, i)->attisdropped)
+				attrs = bms_add_member(attrs,
+									   i + 1 - FirstLowInvalidHeapAttributeNumber);
+		}
+	}
+
+	return attrs;
+}
+
 /*
  * SeqRecheck -- access method routine to recheck a tuple in EvalPlanQual
  */
@@ -99,9 +139,14 @@ SeqRecheck(SeqScanState *node, TupleTableSlot *slot)
  *		ExecSeqScan(node)
  *
  *		Scans the relation sequentially and returns the next qualifying
- *		tuple.
- *		We call the ExecScan() routine and pass it the appropriate
- *		access method functions.
+ *		tuple.  This variant is used when there is no qual to check, no
+ *		projection to do and no EvalPlanQual recheck in progress.
+ *
+ *		We call ExecScanExtended() passing constant NULLs for those, so
+ *		that the compiler can produce a version of the per-tuple loop
+ *		without the corresponding branches.  The other variants below
+ *		do the same for the remaining combinations; ExecInitSeqScan()
+ *		picks the right one.
  * ----------------------------------------------------------------
  */
 static TupleTableSlot *
@@ -109,11 +154,115 @@ ExecSeqScan(PlanState *pstate)
 {
 	SeqScanState *node = castNode(SeqScanState, pstate);
 
+	Assert(pstate->state->es_epq_active == NULL);
+	Assert(pstate->qual == NULL);
+	Assert(pstate->ps_ProjInfo == NULL);
+
+	return ExecScanExtended(&node->ss,
+							(ExecScanAccessMtd) SeqNext,
+							(ExecScanRecheckMtd) SeqRecheck,
+							NULL,
+							NULL,
+							NULL);
+}
+
+/*
+ * Variant of ExecSeqScan() for a scan with a qual but no projection.
+ */
+static TupleTableSlot *
+ExecSeqScanWithQual(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	Assert(pstate->state->es_epq_active == NULL);
+	Assert(pstate->qual != NULL);
+	Assert(pstate->ps_ProjInfo == NULL);
+
+	return ExecScanExtended(&node->ss,
+							(ExecScanAccessMtd) SeqNext,
+							(ExecScanRecheckMtd) SeqRecheck,
+							NULL,
+							pstate->qual,
+							NULL);
+}
+
+/*
+ * Variant of ExecSeqScan() for a scan with a projection but no qual.
+ */
+static TupleTableSlot *
+ExecSeqScanWithProject(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	Assert(pstate->state->es_epq_active == NULL);
+	Assert(pstate->qual == NULL);
+	Assert(pstate->ps_ProjInfo != NULL);
+
+	return ExecScanExtended(&node->ss,
+							(ExecScanAccessMtd) SeqNext,
+							(ExecScanRecheckMtd) SeqRecheck,
+							NULL,
+							NULL,
+							pstate->ps_ProjInfo);
+}
+
+/*
+ * Variant of ExecSeqScan() for a scan with both a qual and a projection.
+ */
+static TupleTableSlot *
+ExecSeqScanWithQualProject(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	Assert(pstate->state->es_epq_active == NULL);
+	Assert(pstate->qual != NULL);
+	Assert(pstate->ps_ProjInfo != NULL);
+
+	return ExecScanExtended(&node->ss,
+							(ExecScanAccessMtd) SeqNext,
+							(ExecScanRecheckMtd) SeqRecheck,
+							NULL,
+							pstate->qual,
+							pstate->ps_ProjInfo);
+}
+
+/*
+ * Variant of ExecSeqScan() for use inside an EvalPlanQual recheck.  This is
+ * rarely executed, so we just use the generic ExecScan().
+ */
+static TupleTableSlot *
+ExecSeqScanEPQ(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
 	return ExecScan(&node->ss,
 					(ExecScanAccessMtd) SeqNext,
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/*
+ * Variant of ExecSeqScan() used while a parent hash join has installed a
+ * runtime filter.  Wraps whichever variant was chosen at init time.
+ */
+static TupleTableSlot *
+ExecSeqScanWithRuntimeFilter(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	for (;;)
+	{
+		TupleTableSlot *slot = node->runtime_filter_next(pstate);
+
+		/* the filter may have been dropped while checking the last tuple */
+		if (TupIsNull(slot) || node->runtime_filter == NULL)
+			return slot;
+
+		if (ExecHashJoinRuntimeFilter(node->runtime_filter, slot))
+			return slot;
+
+		InstrCountFiltered2(node, 1);
+	}
+}
 
 /* ----------------------------------------------------------------
  *		ExecInitSeqScan
@@ -137,7 +286,6 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate = makeNode(SeqScanState);
 	scanstate->ss.ps.plan = (Plan *) node;
 	scanstate->ss.ps.state = estate;
-	scanstate->ss.ps.ExecProcNode = ExecSeqScan;
 
 	/*
 	 * Miscellaneous initialization
@@ -171,9 +319,62 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->scan.plan.qual, (PlanState *) scanstate);
 
+	/*
+	 * Choose the ExecProcNode variant that matches what we need to do for
+	 * each tuple.
+	 */
+	if (estate->es_epq_active != NULL)
+		scanstate->ss.ps.ExecProcNode = ExecSeqScanEPQ;
+	else if (scanstate->ss.ps.qual == NULL)
+	{
+		if (scanstate->ss.ps.ps_ProjInfo == NULL)
+			scanstate->ss.ps.ExecProcNode = ExecSeqScan;
+		else
+			scanstate->ss.ps.ExecProcNode = ExecSeqScanWithProject;
+	}
+	else
+	{
+		if (scanstate->ss.ps.ps_ProjInfo == NULL)
+			scanstate->ss.ps.ExecProcNode = ExecSeqScanWithQual;
+		else
+			scanstate->ss.ps.ExecProcNode = ExecSeqScanWithQualProject;
+	}
+
+	/*
+	 * If the table AM can skip reading unreferenced columns, work out which
+	 * ones we need.
+	 */
+	if (table_supports_column_projection(scanstate->ss.ss_currentRelation))
+		scanstate->proj_attrs =
+			SeqScanNeededColumns(node, scanstate->ss.ss_currentRelation);
+
 	return scanstate;
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanSetRuntimeFilter
+ *
+ *		Starts passing each returned tuple through hjstate's runtime
+ *		filter, which must be our parent; see ExecHashJoinRuntimeFilter().
+ *		Passing NULL stops filtering again.  Tuples the filter removes are
+ *		counted in nfiltered2.
+ * ----------------------------------------------------------------
+ */
+void
+ExecSeqScanSetRuntimeFilter(SeqScanState *node, HashJoinState *hjstate)
+{
+	if (hjstate != NULL && node->runtime_filter == NULL)
+	{
+		node->runtime_filter_next = node->ss.ps.ExecProcNodeReal;
+		ExecSetExecProcNode(&node->ss.ps, ExecSeqScanWithRuntimeFilter);
+		node->runtime_filter_used = true;
+	}
+	else if (hjstate == NULL && node->runtime_filter != NULL)
+		ExecSetExecProcNode(&node->ss.ps, node->runtime_filter_next);
+
+	node->runtime_filter = hjstate;
+}
+
 /* ----------------------------------------------------------------
  *		ExecEndSeqScan
  *
@@ -278,6 +479,8 @@ ExecSeqScanInitializeDSM(SeqScanState *node,
 	shm_toc_insert(pcxt->toc, node->ss.ps.plan->plan_node_id, pscan);
 	node->ss.ss_currentScanDesc =
 		table_beginscan_parallel(node->ss.ss_currentRelation, pscan);
+	table_scan_set_column_projection(node->ss.ss_currentScanDesc,
+									 node->proj_attrs);
 }
 
 /* ----------------------------------------------------------------
@@ -311,4 +514,6 @@ ExecSeqScanInitializeWorker(SeqScanState *node,
 	pscan = shm_toc_lookup(pwcxt->toc, node->ss.ps.plan->plan_node_id, false);
 	node->ss.ss_currentScanDesc =
 		table_beginscan_parallel(node->ss.ss_currentRelation, pscan);
+	table_scan_set_column_projection(node->ss.ss_currentScanDesc,
+									 node->proj_attrs);
 }
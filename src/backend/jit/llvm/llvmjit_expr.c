@@ -534,12 +534,14 @@ llvm_compile_expr(ExprState *state)
 
 			case EEOP_FUNCEXPR:
 			case EEOP_FUNCEXPR_STRICT:
+			case EEOP_FUNCEXPR_STRICT_1:
+			case EEOP_FUNCEXPR_STRICT_2:
 				{
 					FunctionCallInfo fcinfo = op->d.func.fcinfo_data;
 					LLVMValueRef v_fcinfo_isnull;
 					LLVMValueRef v_retval;
 
-					if (opcode == EEOP_FUNCEXPR_STRICT)
+					if (opcode != EEOP_FUNCEXPR)
 					{
 						LLVMBasicBlockRef b_nonull;
 						LLVMBasicBlockRef *b_checkargnulls;
@@ -616,6 +618,98 @@ llvm_compile_expr(ExprState *state)
 					break;
 				}
 
+			case EEOP_INT4_EQ:
+			case EEOP_INT4_NE:
+			case EEOP_INT4_LT:
+			case EEOP_INT4_LE:
+			case EEOP_INT4_GT:
+			case EEOP_INT4_GE:
+			case EEOP_INT8_EQ:
+			case EEOP_INT8_NE:
+			case EEOP_INT8_LT:
+			case EEOP_INT8_LE:
+			case EEOP_INT8_GT:
+			case EEOP_INT8_GE:
+				{
+					FunctionCallInfo fcinfo = op->d.func.fcinfo_data;
+					LLVMValueRef v_fcinfo;
+					LLVMValueRef v_argnull;
+					LLVMValueRef v_arg0;
+					LLVMValueRef v_arg1;
+					LLVMValueRef v_result;
+					LLVMBasicBlockRef b_nonull;
+					LLVMIntPredicate predicate;
+
+					b_nonull = l_bb_before_v(opblocks[opno + 1],
+											 "b.%d.no-null-args", opno);
+
+					v_fcinfo =
+						l_ptr_const(fcinfo, l_ptr(StructFunctionCallInfoData));
+
+					/* strict, so return NULL if either argument is NULL */
+					LLVMBuildStore(b, l_sbool_const(1), v_resnullp);
+					v_argnull = LLVMBuildOr(b,
+											l_funcnull(b, v_fcinfo, 0),
+											l_funcnull(b, v_fcinfo, 1),
+											"");
+					LLVMBuildCondBr(b,
+									LLVMBuildICmp(b, LLVMIntEQ, v_argnull,
+												  l_sbool_const(0), ""),
+									b_nonull,
+									opblocks[opno + 1]);
+
+					LLVMPositionBuilderAtEnd(b, b_nonull);
+
+					v_arg0 = l_funcvalue(b, v_fcinfo, 0);
+					v_arg1 = l_funcvalue(b, v_fcinfo, 1);
+					if (opcode >= EEOP_INT4_EQ && opcode <= EEOP_INT4_GE)
+					{
+						v_arg0 = LLVMBuildTrunc(b, v_arg0, LLVMInt32Type(), "");
+						v_arg1 = LLVMBuildTrunc(b, v_arg1, LLVMInt32Type(), "");
+					}
+
+					switch (opcode)
+					{
+						case EEOP_INT4_EQ:
+						case EEOP_INT8_EQ:
+							predicate = LLVMIntEQ;
+							break;
+						case EEOP_INT4_NE:
+						case EEOP_INT8_NE:
+							predicate = LLVMIntNE;
+							break;
+						case EEOP_INT4_LT:
+						case EEOP_INT8_LT:
+							predicate = LLVMIntSLT;
+							break;
+						case EEOP_INT4_LE:
+						case EEOP_INT8_LE:
+							predicate = LLVMIntSLE;
+							break;
+						case EEOP_INT4_GT:
+						case EEOP_INT8_GT:
+							predicate = LLVMIntSGT;
+							break;
+						case EEOP_INT4_GE:
+						case EEOP_INT8_GE:
+							predicate = LLVMIntSGE;
+							break;
+						default:
+							Assert(false);
+							predicate = 0;	/* prevent compiler warning */
+							break;
+					}
+
+					v_result = LLVMBuildICmp(b, predicate, v_arg0, v_arg1, "");
+					v_result = LLVMBuildZExt(b, v_result, TypeSizeT, "");
+
+					LLVMBuildStore(b, l_sbool_const(0), v_resnullp);
+					LLVMBuildStore(b, v_result, v_resvaluep);
+
+					LLVMBuildBr(b, opblocks[opno + 1]);
+					break;
+				}
+
 			case EEOP_FUNCEXPR_FUSAGE:
 				build_EvalXFunc(b, mod, "ExecEvalFuncExprFusage",
 								v_state, op, v_econtext);
@@ -148,6 +148,7 @@ bool		enable_hashjoin = true;
 bool		enable_gathermerge = true;
 bool		enable_partitionwise_join = false;
 bool		enable_partitionwise_aggregate = false;
+bool		enable_eager_aggregate = false;
 bool		enable_parallel_append = true;
 bool		enable_parallel_hash = true;
 bool		enable_partition_pruning = true;
@@ -583,7 +584,12 @@ cost_index(IndexPath *path, PlannerInfo *root, double loop_count,
 	 * the fraction of main-table tuples we will have to retrieve) and its
 	 * correlation to the main-table tuple order.  We need a cast here because
 	 * pathnodes.h uses a weak function type to avoid including amapi.h.
+	 *
+	 * Mark a partial path parallel-aware first, since the AM may not be able
+	 * to use the same scan strategy for a scan shared among workers.  If no
+	 * workers can be assigned, the path is rejected below anyway.
 	 */
+	path->path.parallel_aware = partial_path;
 	amcostestimate = (amcostestimate_function) index->amcostestimate;
 	amcostestimate(root, path, loop_count,
 				   &indexStartupCost, &indexTotalCost,
@@ -744,8 +750,6 @@ cost_index(IndexPath *path, PlannerInfo *root, double loop_count,
 		 */
 		if (path->path.parallel_workers <= 0)
 			return;
-
-		path->path.parallel_aware = true;
 	}
 
 	/*
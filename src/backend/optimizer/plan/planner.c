@@ -20,14 +20,17 @@
 
 #include "access/genam.h"
 #include "access/htup_details.h"
+#include "access/nbtree.h"
 #include "access/parallel.h"
 #include "access/sysattr.h"
 #include "access/table.h"
 #include "access/xact.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_constraint.h"
 #include "catalog/pg_inherits.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
+#include "commands/defrem.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
 #include "foreign/fdwapi.h"
@@ -56,6 +59,7 @@
 #include "optimizer/tlist.h"
 #include "parser/analyze.h"
 #include "parser/parse_agg.h"
+#include "parser/parse_oper.h"
 #include "parser/parsetree.h"
 #include "partitioning/partdesc.h"
 #include "rewrite/rewriteManip.h"
@@ -69,6 +73,7 @@
 double		cursor_tuple_fraction = DEFAULT_CURSOR_TUPLE_FRACTION;
 int			force_parallel_mode = FORCE_PARALLEL_OFF;
 bool		parallel_leader_participation = true;
+int			parallel_leader_merge_only_workers = 0;
 
 /* Hook for plugins to get control in planner() */
 planner_hook_type planner_hook = NULL;
@@ -231,6 +236,9 @@ static RelOptInfo *create_partial_grouping_paths(PlannerInfo *root,
 												 GroupPathExtraData *extra,
 												 bool force_rel_creation);
 static void gather_grouping_paths(PlannerInfo *root, RelOptInfo *rel);
+static void add_eager_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
+									 RelOptInfo *grouped_rel, double dNumGroups,
+									 GroupPathExtraData *extra);
 static bool can_partial_agg(PlannerInfo *root);
 static void apply_scanjoin_target_to_paths(PlannerInfo *root,
 										   RelOptInfo *rel,
@@ -3697,6 +3705,13 @@ create_ordinary_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
 							  partially_grouped_rel, agg_costs, gd,
 							  dNumGroups, extra);
 
+	/* Consider partial aggregation below the join, too */
+	if (enable_eager_aggregate &&
+		(extra->flags & GROUPING_CAN_PARTIAL_AGG) != 0 &&
+		extra->patype == PARTITIONWISE_AGGREGATE_NONE)
+		add_eager_grouping_paths(root, input_rel, grouped_rel, dNumGroups,
+								 extra);
+
 	/* Give a helpful error if we failed to find any implementation */
 	if (grouped_rel->pathlist == NIL)
 		ereport(ERROR,
@@ -7019,6 +7034,376 @@ gather_grouping_paths(PlannerInfo *root, RelOptInfo *rel)
 	}
 }
 
+/*
+ * add_eager_grouping_paths
+ *
+ * Consider aggregating one input of a join partially before the join, and
+ * finalizing the aggregation on the join result ("eager aggregation").  When
+ * many rows of that input share the same join key, this greatly reduces the
+ * number of rows fed to the join.
+ *
+ * Joining a partial aggregate state to k rows of the other relation and
+ * combining the k copies produces the same result as aggregating the k
+ * joined copies of each input row, so this is correct for any aggregate
+ * supporting partial mode.  Duplicating rows is only a problem for DISTINCT
+ * or ordered aggregates, which never support partial mode anyway.
+ *
+ * For now, we only handle an inner join of two base relations, where all
+ * aggregate arguments come from one of them.  The partial aggregation on
+ * that relation is grouped by its columns needed above it, that is its join
+ * columns plus any used in grouping expressions or outside of aggregates;
+ * only hashed partial aggregation and hash joins are considered.
+ */
+static void
+add_eager_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
+						 RelOptInfo *grouped_rel, double dNumGroups,
+						 GroupPathExtraData *extra)
+{
+	Query	   *parse = root->parse;
+	AggClauseCosts *agg_partial_costs = &extra->agg_partial_costs;
+	AggClauseCosts *agg_final_costs = &extra->agg_final_costs;
+	bool		can_hash = (extra->flags & GROUPING_CAN_USE_HASH) != 0;
+	List	   *exprs;
+	List	   *aggrefs = NIL;
+	Relids		agg_relids = NULL;
+	int			relid;
+	int			otherrelid;
+	RelOptInfo *aggrel;
+	RelOptInfo *otherrel;
+	PathTarget *join_target;
+	List	   *restrictlist;
+	List	   *group_vars = NIL;
+	List	   *group_clauses = NIL;
+	PathTarget *input_target;
+	PathTarget *partial_target;
+	Index		sgref = 0;
+	double		dNumPartialGroups;
+	RelOptInfo *grouped_aggrel;
+	RelOptInfo *grouped_joinrel;
+	Path	   *partial_path;
+	Path	   *join_path = NULL;
+	SpecialJoinInfo *sjinfo;
+	JoinPathExtraData join_extra;
+	ListCell   *lc;
+
+	/*
+	 * Check for a plain inner join of two base relations.  Outer joins would
+	 * need the partial aggregates of null-extended rows to be computed, and
+	 * PlaceHolderVars and lateral references could tie grouping expressions
+	 * to a particular join level.
+	 */
+	if (input_rel->reloptkind != RELOPT_JOINREL ||
+		bms_num_members(input_rel->relids) != 2 ||
+		root->join_info_list != NIL ||
+		root->placeholder_list != NIL ||
+		root->hasLateralRTEs ||
+		!parse->hasAggs)
+		return;
+
+	/*
+	 * Find the relation that all aggregate arguments come from.  Aggregates
+	 * without any Vars, like count(*), can be computed on either side.
+	 */
+	exprs = pull_var_clause((Node *) grouped_rel->reltarget->exprs,
+							PVC_INCLUDE_AGGREGATES |
+							PVC_RECURSE_WINDOWFUNCS |
+							PVC_INCLUDE_PLACEHOLDERS);
+	exprs = list_concat(exprs,
+						pull_var_clause(extra->havingQual,
+										PVC_INCLUDE_AGGREGATES |
+										PVC_RECURSE_WINDOWFUNCS |
+										PVC_INCLUDE_PLACEHOLDERS));
+	foreach(lc, exprs)
+	{
+		Node	   *expr = (Node *) lfirst(lc);
+
+		if (!IsA(expr, Aggref))
+			continue;
+		if (contain_volatile_functions(expr))
+			return;
+		aggrefs = lappend(aggrefs, expr);
+		agg_relids = bms_add_members(agg_relids, pull_varnos(root, expr));
+	}
+	if (!bms_get_singleton_member(agg_relids, &relid) ||
+		!bms_is_member(relid, input_rel->relids))
+		return;
+
+	otherrelid = bms_next_member(input_rel->relids, -1);
+	if (otherrelid == relid)
+		otherrelid = bms_next_member(input_rel->relids, otherrelid);
+
+	aggrel = find_base_rel(root, relid);
+	otherrel = find_base_rel(root, otherrelid);
+	if (aggrel->reloptkind != RELOPT_BASEREL ||
+		otherrel->reloptkind != RELOPT_BASEREL ||
+		aggrel->cheapest_total_path == NULL ||
+		otherrel->cheapest_total_path == NULL ||
+		aggrel->cheapest_total_path->param_info != NULL ||
+		otherrel->cheapest_total_path->param_info != NULL)
+		return;
+
+	/* The join emits the same target as a partial aggregate would */
+	join_target = make_partial_grouping_target(root, grouped_rel->reltarget,
+											   extra->havingQual);
+	set_pathtarget_cost_width(root, join_target);
+
+	/* Collect the join clauses, as build_joinrel_restrictlist() would */
+	restrictlist = generate_join_implied_equalities(root,
+													input_rel->relids,
+													otherrel->relids,
+													aggrel);
+	foreach(lc, aggrel->joininfo)
+	{
+		RestrictInfo *rinfo = lfirst_node(RestrictInfo, lc);
+
+		if (bms_is_subset(rinfo->required_relids, input_rel->relids))
+			restrictlist = list_append_unique_ptr(restrictlist, rinfo);
+	}
+
+	/*
+	 * The partial aggregation must be grouped by every column of aggrel used
+	 * above it, outside of aggregates.  That includes its join columns.
+	 */
+	exprs = pull_var_clause((Node *) join_target->exprs,
+							PVC_INCLUDE_AGGREGATES |
+							PVC_INCLUDE_PLACEHOLDERS);
+	foreach(lc, restrictlist)
+	{
+		RestrictInfo *rinfo = lfirst_node(RestrictInfo, lc);
+
+		exprs = list_concat(exprs,
+							pull_var_clause((Node *) rinfo->clause,
+											PVC_INCLUDE_PLACEHOLDERS));
+	}
+	foreach(lc, exprs)
+	{
+		Var		   *var = (Var *) lfirst(lc);
+
+		if (IsA(var, Var) && var->varno == relid)
+		{
+			if (var->varattno <= 0)
+				return;
+			group_vars = list_append_unique(group_vars, var);
+		}
+	}
+
+	/*
+	 * Grouping puts equal values in one group, but only one of them survives
+	 * for the join and the grouping above to see.  That is fine only if equal
+	 * values are indistinguishable, which is what btree "equalimage" support
+	 * functions tell us; numeric, for example, doesn't qualify because 1.0
+	 * and 1.00 are equal.  The grouping must also be hashable.
+	 */
+	foreach(lc, group_vars)
+	{
+		Var		   *var = (Var *) lfirst(lc);
+		Oid			opclass;
+		Oid			opcintype;
+		Oid			equalimageproc;
+		Oid			sortop;
+		Oid			eqop;
+		bool		hashable;
+		SortGroupClause *sgc;
+
+		opclass = GetDefaultOpClass(var->vartype, BTREE_AM_OID);
+		if (!OidIsValid(opclass))
+			return;
+		opcintype = get_opclass_input_type(opclass);
+		equalimageproc = get_opfamily_proc(get_opclass_family(opclass),
+										   opcintype, opcintype,
+										   BTEQUALIMAGE_PROC);
+		if (!OidIsValid(equalimageproc) ||
+			!DatumGetBool(OidFunctionCall1Coll(equalimageproc,
+											   var->varcollid,
+											   ObjectIdGetDatum(opcintype))))
+			return;
+
+		get_sort_group_operators(var->vartype, false, true, false,
+								 &sortop, &eqop, NULL, &hashable);
+		if (!hashable)
+			return;
+
+		sgc = makeNode(SortGroupClause);
+		sgc->tleSortGroupRef = ++sgref;
+		sgc->eqop = eqop;
+		sgc->sortop = sortop;
+		sgc->nulls_first = false;
+		sgc->hashable = true;
+		group_clauses = lappend(group_clauses, sgc);
+	}
+
+	/*
+	 * Build the input target of the partial aggregation, with its grouping
+	 * columns labeled, and its output target.
+	 */
+	input_target = create_empty_pathtarget();
+	partial_target = create_empty_pathtarget();
+	sgref = 0;
+	foreach(lc, group_vars)
+	{
+		add_column_to_pathtarget(input_target, lfirst(lc), ++sgref);
+		add_column_to_pathtarget(partial_target, lfirst(lc), 0);
+	}
+	add_new_columns_to_pathtarget(input_target,
+								  pull_var_clause((Node *) aggrefs,
+												  PVC_RECURSE_AGGREGATES));
+	set_pathtarget_cost_width(root, input_target);
+
+	foreach(lc, join_target->exprs)
+	{
+		if (IsA(lfirst(lc), Aggref))
+			add_column_to_pathtarget(partial_target, lfirst(lc), 0);
+	}
+	set_pathtarget_cost_width(root, partial_target);
+
+	if (!extra->partial_costs_set)
+	{
+		MemSet(agg_partial_costs, 0, sizeof(AggClauseCosts));
+		MemSet(agg_final_costs, 0, sizeof(AggClauseCosts));
+		get_agg_clause_costs(root, AGGSPLIT_INITIAL_SERIAL, agg_partial_costs);
+		get_agg_clause_costs(root, AGGSPLIT_FINAL_DESERIAL, agg_final_costs);
+		extra->partial_costs_set = true;
+	}
+
+	/*
+	 * Build the partially aggregated relation.  It's a flat copy of aggrel,
+	 * so that join costing still sees the relids and statistics of the base
+	 * relation.
+	 */
+	if (group_vars != NIL)
+		dNumPartialGroups = estimate_num_groups(root, group_vars,
+												aggrel->rows, NULL, NULL);
+	else
+		dNumPartialGroups = 1;
+
+	grouped_aggrel = makeNode(RelOptInfo);
+	memcpy(grouped_aggrel, aggrel, sizeof(RelOptInfo));
+	grouped_aggrel->rows = dNumPartialGroups;
+	grouped_aggrel->reltarget = partial_target;
+	grouped_aggrel->pathlist = NIL;
+	grouped_aggrel->partial_pathlist = NIL;
+
+	partial_path = (Path *)
+		create_projection_path(root, aggrel, aggrel->cheapest_total_path,
+							   input_target);
+	partial_path = (Path *)
+		create_agg_path(root,
+						grouped_aggrel,
+						partial_path,
+						partial_target,
+						group_clauses ? AGG_HASHED : AGG_PLAIN,
+						AGGSPLIT_INITIAL_SERIAL,
+						group_clauses,
+						NIL,
+						agg_partial_costs,
+						dNumPartialGroups);
+
+	/*
+	 * Build the grouped join relation, likewise a flat copy of the real one.
+	 * Each partial group joins to as many rows as each of its members did.
+	 */
+	grouped_joinrel = makeNode(RelOptInfo);
+	memcpy(grouped_joinrel, input_rel, sizeof(RelOptInfo));
+	grouped_joinrel->rows =
+		clamp_row_est(input_rel->rows * dNumPartialGroups / aggrel->rows);
+	grouped_joinrel->reltarget = join_target;
+	grouped_joinrel->pathlist = NIL;
+	grouped_joinrel->partial_pathlist = NIL;
+
+	sjinfo = makeNode(SpecialJoinInfo);
+	sjinfo->min_lefthand = aggrel->relids;
+	sjinfo->min_righthand = otherrel->relids;
+	sjinfo->syn_lefthand = aggrel->relids;
+	sjinfo->syn_righthand = otherrel->relids;
+	sjinfo->jointype = JOIN_INNER;
+
+	MemSet(&join_extra, 0, sizeof(JoinPathExtraData));
+	join_extra.restrictlist = restrictlist;
+	join_extra.sjinfo = sjinfo;
+
+	/* Consider hashing either side */
+	for (int i = 0; i < 2; i++)
+	{
+		Path	   *outer_path = (i == 0) ? partial_path : otherrel->cheapest_total_path;
+		Path	   *inner_path = (i == 0) ? otherrel->cheapest_total_path : partial_path;
+		List	   *hashclauses = NIL;
+		JoinCostWorkspace workspace;
+		Path	   *path;
+
+		foreach(lc, restrictlist)
+		{
+			RestrictInfo *rinfo = lfirst_node(RestrictInfo, lc);
+
+			if (!rinfo->can_join || !OidIsValid(rinfo->hashjoinoperator))
+				continue;
+
+			if (bms_is_subset(rinfo->left_relids, outer_path->parent->relids) &&
+				bms_is_subset(rinfo->right_relids, inner_path->parent->relids))
+				rinfo->outer_is_left = true;
+			else if (bms_is_subset(rinfo->left_relids, inner_path->parent->relids) &&
+					 bms_is_subset(rinfo->right_relids, outer_path->parent->relids))
+				rinfo->outer_is_left = false;
+			else
+				continue;
+
+			hashclauses = lappend(hashclauses, rinfo);
+		}
+		if (hashclauses == NIL)
+			return;
+
+		initial_cost_hashjoin(root, &workspace, JOIN_INNER, hashclauses,
+							  outer_path, inner_path, &join_extra, false);
+		path = (Path *) create_hashjoin_path(root, grouped_joinrel, JOIN_INNER,
+											 &workspace, &join_extra,
+											 outer_path, inner_path, false,
+											 restrictlist, NULL, hashclauses);
+		if (join_path == NULL || path->total_cost < join_path->total_cost)
+			join_path = path;
+	}
+
+	/* Finally, combine the partial aggregates */
+	if (parse->groupClause == NIL)
+		add_path(grouped_rel, (Path *)
+				 create_agg_path(root,
+								 grouped_rel,
+								 join_path,
+								 grouped_rel->reltarget,
+								 AGG_PLAIN,
+								 AGGSPLIT_FINAL_DESERIAL,
+								 NIL,
+								 (List *) extra->havingQual,
+								 agg_final_costs,
+								 dNumGroups));
+	else if (can_hash)
+		add_path(grouped_rel, (Path *)
+				 create_agg_path(root,
+								 grouped_rel,
+								 join_path,
+								 grouped_rel->reltarget,
+								 AGG_HASHED,
+								 AGGSPLIT_FINAL_DESERIAL,
+								 parse->groupClause,
+								 (List *) extra->havingQual,
+								 agg_final_costs,
+								 dNumGroups));
+	else
+		add_path(grouped_rel, (Path *)
+				 create_agg_path(root,
+								 grouped_rel,
+								 (Path *) create_sort_path(root,
+														   grouped_rel,
+														   join_path,
+														   root->group_pathkeys,
+														   -1.0),
+								 grouped_rel->reltarget,
+								 AGG_SORTED,
+								 AGGSPLIT_FINAL_DESERIAL,
+								 parse->groupClause,
+								 (List *) extra->havingQual,
+								 agg_final_costs,
+								 dNumGroups));
+}
+
 /*
  * can_partial_agg
  *
@@ -6611,6 +6611,40 @@ add_predicate_to_index_quals(IndexOptInfo *index, List *indexQuals)
 	return list_concat(predExtraQuals, indexQuals);
 }
 
+/*
+ * Estimate the number of distinct values in a btree index's first column,
+ * for the purpose of costing skipping scans.  Returns 0 if we only have a
+ * default estimate, since it's not worth betting a plan on that.
+ */
+static double
+btree_leading_numdistinct(PlannerInfo *root, IndexOptInfo *index)
+{
+	VariableStatData vardata;
+	Node	   *node;
+	double		ndistinct;
+	bool		isdefault;
+
+	if (index->indexkeys[0] != 0)
+	{
+		RangeTblEntry *rte = planner_rt_fetch(index->rel->relid, root);
+		Oid			vartype;
+		int32		vartypmod;
+		Oid			varcollid;
+
+		get_atttypetypmodcoll(rte->relid, index->indexkeys[0],
+							  &vartype, &vartypmod, &varcollid);
+		node = (Node *) makeVar(index->rel->relid, index->indexkeys[0],
+								vartype, vartypmod, varcollid, 0);
+	}
+	else
+		node = (Node *) linitial(index->indexprs);
+
+	examine_variable(root, node, 0, &vardata);
+	ndistinct = get_variable_numdistinct(&vardata, &isdefault);
+	ReleaseVariableStats(vardata);
+
+	return isdefault ? 0 : ndistinct;
+}
 
 void
 btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
@@ -6631,6 +6665,7 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	bool		found_saop;
 	bool		found_is_null_op;
 	double		num_sa_scans;
+	double		num_skip_scans;
 	ListCell   *lc;
 
 	/*
@@ -6771,6 +6806,68 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 		numIndexTuples = rint(numIndexTuples / num_sa_scans);
 	}
 
+	/*
+	 * If there are no quals on the first index column, but there are quals
+	 * on the second one, a forward scan can skip from one run of matching
+	 * tuples to the next instead of reading the whole index (see
+	 * _bt_skip_setup()).  Such a scan visits the tuples selected by the
+	 * second column's quals, plus about a leaf page's worth of tuples for
+	 * each distinct first column value, and descends the tree once per
+	 * distinct value.  Use that estimate if it's cheaper.  Parallel scans
+	 * never skip.
+	 */
+	num_skip_scans = 0;
+	if (index->nkeycolumns >= 2 &&
+		!ScanDirectionIsBackward(path->indexscandir) &&
+		!path->path.parallel_aware &&
+		index->pages > 0 && index->tuples > 0 &&
+		path->indexclauses != NIL &&
+		linitial_node(IndexClause, path->indexclauses)->indexcol == 1)
+	{
+		List	   *skipQuals = NIL;
+		bool		found_array = false;
+
+		foreach(lc, path->indexclauses)
+		{
+			IndexClause *iclause = lfirst_node(IndexClause, lc);
+			ListCell   *lc2;
+
+			foreach(lc2, iclause->indexquals)
+			{
+				RestrictInfo *rinfo = lfirst_node(RestrictInfo, lc2);
+
+				/* array keys disable skipping altogether */
+				if (IsA(rinfo->clause, ScalarArrayOpExpr))
+					found_array = true;
+				else if (iclause->indexcol == 1 && IsA(rinfo->clause, OpExpr))
+					skipQuals = lappend(skipQuals, rinfo);
+			}
+		}
+
+		if (!found_array && skipQuals != NIL)
+		{
+			double		ndistinct = btree_leading_numdistinct(root, index);
+
+			if (ndistinct > 0)
+			{
+				double		skipTuples;
+
+				skipTuples = clauselist_selectivity(root,
+													add_predicate_to_index_quals(index, skipQuals),
+													index->rel->relid,
+													JOIN_INNER,
+													NULL) * index->rel->tuples;
+				skipTuples += ndistinct * index->tuples / index->pages;
+				skipTuples = rint(skipTuples);
+				if (skipTuples < numIndexTuples)
+				{
+					numIndexTuples = skipTuples;
+					num_skip_scans = ndistinct;
+				}
+			}
+		}
+	}
+
 	/*
 	 * Now do generic index cost estimation.
 	 */
@@ -6788,13 +6885,14 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	 *
 	 * If there are ScalarArrayOpExprs, charge this once per SA scan.  The
 	 * ones after the first one are not startup cost so far as the overall
-	 * plan is concerned, so add them only to "total" cost.
+	 * plan is concerned, so add them only to "total" cost.  Likewise for the
+	 * descents made by a skipping scan.
 	 */
 	if (index->tuples > 1)		/* avoid computing log(0) */
 	{
 		descentCost = ceil(log(index->tuples) / log(2.0)) * cpu_operator_cost;
 		costs.indexStartupCost += descentCost;
-		costs.indexTotalCost += costs.num_sa_scans * descentCost;
+		costs.indexTotalCost += (costs.num_sa_scans + num_skip_scans) * descentCost;
 	}
 
 	/*
@@ -6805,11 +6903,12 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	 * in cases where only a single leaf page is expected to be visited.  This
 	 * cost is somewhat arbitrarily set at 50x cpu_operator_cost per page
 	 * touched.  The number of such pages is btree tree height plus one (ie,
-	 * we charge for the leaf page too).  As above, charge once per SA scan.
+	 * we charge for the leaf page too).  As above, charge once per SA scan
+	 * and once per skip.
 	 */
 	descentCost = (index->tree_height + 1) * 50.0 * cpu_operator_cost;
 	costs.indexStartupCost += descentCost;
-	costs.indexTotalCost += costs.num_sa_scans * descentCost;
+	costs.indexTotalCost += (costs.num_sa_scans + num_skip_scans) * descentCost;
 
 	/*
 	 * If we can get an estimate of the first column's ordering correlation C
@@ -2001,15 +2001,19 @@ psql_completion(const char *text, int start, int end)
 		COMPLETE_WITH("fillfactor",
 					  "deduplicate_items",	/* BTREE */
 					  "fastupdate", "gin_pending_list_limit",	/* GIN */
+					  "background_cleanup",	/* GIN */
 					  "buffering",	/* GiST */
-					  "pages_per_range", "autosummarize"	/* BRIN */
+					  "pages_per_range", "autosummarize",	/* BRIN */
+					  "inline_summarize"	/* BRIN */
 			);
 	else if (Matches("ALTER", "INDEX", MatchAny, "SET", "("))
 		COMPLETE_WITH("fillfactor =",
 					  "deduplicate_items =",	/* BTREE */
 					  "fastupdate =", "gin_pending_list_limit =",	/* GIN */
+					  "background_cleanup =",	/* GIN */
 					  "buffering =",	/* GiST */
-					  "pages_per_range =", "autosummarize ="	/* BRIN */
+					  "pages_per_range =", "autosummarize =",	/* BRIN */
+					  "inline_summarize ="	/* BRIN */
 			);
 	else if (Matches("ALTER", "INDEX", MatchAny, "NO", "DEPENDS"))
 		COMPLETE_WITH("ON EXTENSION");
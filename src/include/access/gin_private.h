@@ -27,6 +27,8 @@ typedef struct GinOptions
 	int32		vl_len_;		/* varlena header (do not touch directly!) */
 	bool		useFastUpdate;	/* use fast updates? */
 	int			pendingListCleanupSize; /* maximum size of pending list */
+	bool		backgroundCleanup;	/* leave pending list cleanup to
+									 * autovacuum? */
 } GinOptions;
 
 #define GIN_DEFAULT_USE_FASTUPDATE	true
@@ -42,6 +44,20 @@ typedef struct GinOptions
 	 ((GinOptions *) (relation)->rd_options)->pendingListCleanupSize != -1 ? \
 	 ((GinOptions *) (relation)->rd_options)->pendingListCleanupSize : \
 	 gin_pending_list_limit)
+#define GIN_DEFAULT_BACKGROUND_CLEANUP	false
+#define GinGetBackgroundCleanup(relation) \
+	(AssertMacro(relation->rd_rel->relkind == RELKIND_INDEX && \
+				 relation->rd_rel->relam == GIN_AM_OID), \
+	 (relation)->rd_options ? \
+	 ((GinOptions *) (relation)->rd_options)->backgroundCleanup : \
+	 GIN_DEFAULT_BACKGROUND_CLEANUP)
+
+/*
+ * With background cleanup, inserters still clean up the pending list
+ * themselves once it grows to this many times its cleanup size, in case
+ * autovacuum can't keep up.
+ */
+#define GIN_BACKGROUND_CLEANUP_FACTOR	4
 
 
 /* Macros for buffer lock/unlock operations */
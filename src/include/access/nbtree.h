@@ -1045,6 +1045,28 @@ typedef struct BTScanOpaqueData
 	BTArrayKeyInfo *arrayKeys;	/* info about each equality-type array key */
 	MemoryContext arrayContext; /* scan-lifespan context for array data */
 
+	/*
+	 * Skip scan state, used when the scan has no key on the index's first
+	 * column but does constrain the second one (see _bt_skip_setup()).
+	 */
+	bool		skipEnabled;	/* may we skip over useless leaf pages? */
+	bool		skipHasLow;		/* is skipLowKey valid? */
+	bool		skipHasHigh;	/* is skipHighKey valid? */
+	ScanKeyData skipLowKey;		/* 2nd column's start bound, insertion-style */
+	ScanKeyData skipHighKey;	/* 2nd column's end bound, insertion-style */
+	bool		skipPending;	/* skip ahead after leaving skipPage? */
+	bool		skipNextGroup;	/* skip past skipTuple's 1st column value? */
+	BlockNumber skipPage;		/* page skipTuple was copied from */
+	IndexTuple	skipTuple;		/* last item on skipPage (NULL if unused) */
+
+	/*
+	 * Key range chunk state, used when a parallel scan has been divided up
+	 * using the root page's separator keys (see _bt_chunk_init()).
+	 */
+	bool		chunked;		/* is the parallel scan range-partitioned? */
+	bool		chunkDone;		/* reached the end of our current chunk? */
+	BTScanInsert chunkEndKey;	/* start of the next chunk (NULL if none) */
+
 	/* info about killed items if any (killedItems is NULL if never used) */
 	int		   *killedItems;	/* currPos.items indexes of killed items */
 	int			numKilled;		/* number of currently stored items */
@@ -1150,6 +1172,10 @@ extern bool btcanreturn(Relation index, int attno);
 extern bool _bt_parallel_seize(IndexScanDesc scan, BlockNumber *pageno);
 extern void _bt_parallel_release(IndexScanDesc scan, BlockNumber scan_page);
 extern void _bt_parallel_done(IndexScanDesc scan);
+extern IndexTuple _bt_parallel_chunks_init(IndexScanDesc scan, Page rootpage,
+										   OffsetNumber first);
+extern bool _bt_parallel_next_chunk(IndexScanDesc scan, IndexTuple *lowbound,
+									IndexTuple *highbound);
 extern void _bt_parallel_advance_array_keys(IndexScanDesc scan);
 
 /*
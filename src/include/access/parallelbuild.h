@@ -0,0 +1,123 @@
+/*-------------------------------------------------------------------------
+ *
+ * parallelbuild.h
+ *	  Infrastructure shared by parallel index builds.
+ *
+ *
+ * Portions Copyright (c) 1996-2022, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/access/parallelbuild.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PARALLELBUILD_H
+#define PARALLELBUILD_H
+
+#include "access/parallel.h"
+#include "access/relscan.h"
+#include "executor/instrument.h"
+#include "storage/condition_variable.h"
+#include "storage/spin.h"
+#include "utils/relcache.h"
+#include "utils/snapshot.h"
+
+/* We don't want this file to depend on tuplesort.h. */
+struct Sharedsort;
+
+/*
+ * Status for index builds performed in parallel.  This is allocated in a
+ * dynamic shared memory segment, as the first member of a larger struct
+ * holding the access method's own state.  If the participants share a
+ * parallel table scan, its descriptor follows that struct.  If they each
+ * perform a partial sort, there is a separate tuplesort TOC entry.
+ */
+typedef struct IndexBuildShared
+{
+	/* These fields are not modified during the build */
+	Oid			heaprelid;
+	Oid			indexrelid;
+	bool		isconcurrent;
+	int			scantuplesortstates;	/* participants planned for */
+	Size		scanoffset;		/* offset of table scan, or 0 if none */
+
+	/* Signalled by each participant once it has finished its share */
+	ConditionVariable workersdonecv;
+
+	/*
+	 * mutex protects the fields below, and any mutable state the access
+	 * method adds to the struct.
+	 */
+	slock_t		mutex;
+
+	/* Mutable state, reported back to the leader at the end of the scan */
+	int			nparticipantsdone;
+	double		reltuples;
+	double		indtuples;
+	bool		brokenhotchain;
+} IndexBuildShared;
+
+/* Return pointer to an IndexBuildShared's parallel table scan */
+#define ParallelTableScanFromIndexBuildShared(shared) \
+	(AssertMacro((shared)->scanoffset != 0), \
+	 (ParallelTableScanDesc) ((char *) (shared) + (shared)->scanoffset))
+
+/*
+ * Status for leader in parallel index build.
+ */
+typedef struct IndexBuildLeader
+{
+	/* parallel context itself */
+	ParallelContext *pcxt;
+
+	/*
+	 * nparticipants is the number of participants, including the leader,
+	 * which is the exact number of launched workers plus one.
+	 */
+	int			nparticipants;
+
+	/*
+	 * Leader process convenience pointers to shared state (leader avoids TOC
+	 * lookups).
+	 *
+	 * sharedsort is NULL unless the participants perform partial sorts.
+	 * snapshot is the snapshot used by the scan iff an MVCC snapshot is
+	 * required.
+	 */
+	IndexBuildShared *shared;
+	struct Sharedsort *sharedsort;
+	Snapshot	snapshot;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+} IndexBuildLeader;
+
+/* Leader */
+extern IndexBuildLeader *index_parallel_build_begin(const char *function_name,
+													Relation heap,
+													Relation index,
+													bool isconcurrent,
+													int request,
+													Size sharedsize,
+													bool scan, bool sort);
+extern bool index_parallel_build_launch(IndexBuildLeader *leader);
+extern double index_parallel_build_wait(IndexBuildLeader *leader,
+										double *indtuples,
+										bool *brokenhotchain);
+extern void index_parallel_build_end(IndexBuildLeader *leader);
+
+/* All participants */
+extern void index_parallel_build_report(IndexBuildShared *shared,
+										double reltuples, double indtuples,
+										bool brokenhotchain);
+
+/* Workers */
+extern IndexBuildShared *index_parallel_build_attach(dsm_segment *seg,
+													 shm_toc *toc,
+													 Relation *heap,
+													 Relation *index,
+													 struct Sharedsort **sharedsort);
+extern void index_parallel_build_detach(shm_toc *toc,
+										IndexBuildShared *shared,
+										Relation heap, Relation index);
+
+#endif							/* PARALLELBUILD_H */
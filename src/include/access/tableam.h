@@ -129,6 +129,22 @@ typedef struct TM_FailureData
 	bool		traversed;
 } TM_FailureData;
 
+/*
+ * Result codes for table_update(..., update_indexes*..).
+ * Used to determine which indexes to update.
+ */
+typedef enum TU_UpdateIndexes
+{
+	/* No indexed columns were updated (incl. TID addressing of tuple) */
+	TU_None,
+
+	/* A non-summarizing indexed column was updated, or the TID has changed */
+	TU_All,
+
+	/* Only summarized columns were updated, TID is unchanged */
+	TU_Summarizing
+} TU_UpdateIndexes;
+
 /*
  * State used when calling table_index_delete_tuples().
  *
@@ -357,6 +373,24 @@ typedef struct TableAmRoutine
 											  ScanDirection direction,
 											  TupleTableSlot *slot);
 
+	/*
+	 * Optional callback to inform the AM which columns of the relation the
+	 * caller of a sequential scan will actually look at.  `attrs` contains
+	 * attribute numbers offset by FirstLowInvalidHeapAttributeNumber, as
+	 * produced by pull_varattnos(); whole-row references have been expanded
+	 * into all the columns.  NULL means that no columns are needed, as in
+	 * "SELECT 1 FROM tab".
+	 *
+	 * An AM that stores columns separately can use this to avoid reading
+	 * the data of unreferenced columns at all.  Columns not included in
+	 * `attrs` may be returned as NULLs in the slot.  The projection stays in
+	 * effect across scan_rescan calls.  It is called after scan_begin, and
+	 * before the first call to scan_getnextslot.  AMs that store whole rows
+	 * together, like heap, have no use for it and can leave it NULL.
+	 */
+	void		(*scan_set_column_projection) (TableScanDesc scan,
+											   Bitmapset *attrs);
+
 	/* ------------------------------------------------------------------------
 	 * Parallel table scan related functions.
 	 * ------------------------------------------------------------------------
@@ -526,7 +560,7 @@ typedef struct TableAmRoutine
 								 bool wait,
 								 TM_FailureData *tmfd,
 								 LockTupleMode *lockmode,
-								 bool *update_indexes);
+								 TU_UpdateIndexes *update_indexes);
 
 	/* see table_tuple_lock() for reference about parameters */
 	TM_Result	(*tuple_lock) (Relation rel,
@@ -1104,6 +1138,27 @@ table_scan_getnextslot_tidrange(TableScanDesc sscan, ScanDirection direction,
 															   slot);
 }
 
+/*
+ * Inform the AM which columns of the relation a sequential scan needs, see
+ * the scan_set_column_projection callback.  This is a no-op for AMs that
+ * don't implement the callback.
+ */
+static inline void
+table_scan_set_column_projection(TableScanDesc sscan, Bitmapset *attrs)
+{
+	if (sscan->rs_rd->rd_tableam->scan_set_column_projection != NULL)
+		sscan->rs_rd->rd_tableam->scan_set_column_projection(sscan, attrs);
+}
+
+/*
+ * Returns true if the AM of `rel` can make use of a column projection.
+ */
+static inline bool
+table_supports_column_projection(Relation rel)
+{
+	return rel->rd_tableam->scan_set_column_projection != NULL;
+}
+
 
 /* ----------------------------------------------------------------------------
  * Parallel table scan related functions.
@@ -1485,8 +1540,10 @@ table_tuple_delete(Relation rel, ItemPointer tid, CommandId cid,
  * Output parameters:
  *	tmfd - filled in failure cases (see below)
  *	lockmode - filled with lock mode acquired on tuple
- *  update_indexes - in success cases this is set to true if new index entries
- *		are required for this tuple
+ *	update_indexes - in success cases this is set to TU_All if new entries
+ *		are required in all indexes, to TU_Summarizing if only summarizing
+ *		indexes (see amsummarizing) need new entries for this tuple, and to
+ *		TU_None if no index needs to be updated
  *
  * Normal, successful return value is TM_Ok, which means we did actually
  * update it.  Failure return codes are TM_SelfModified, TM_Updated, and
@@ -1506,7 +1563,7 @@ static inline TM_Result
 table_tuple_update(Relation rel, ItemPointer otid, TupleTableSlot *slot,
 				   CommandId cid, Snapshot snapshot, Snapshot crosscheck,
 				   bool wait, TM_FailureData *tmfd, LockTupleMode *lockmode,
-				   bool *update_indexes)
+				   TU_UpdateIndexes *update_indexes)
 {
 	return rel->rd_tableam->tuple_update(rel, otid, slot,
 										 cid, snapshot, crosscheck,
@@ -2029,7 +2086,7 @@ extern void simple_table_tuple_delete(Relation rel, ItemPointer tid,
 									  Snapshot snapshot);
 extern void simple_table_tuple_update(Relation rel, ItemPointer otid,
 									  TupleTableSlot *slot, Snapshot snapshot,
-									  bool *update_indexes);
+									  TU_UpdateIndexes *update_indexes);
 
 
 /* ----------------------------------------------------------------------------
@@ -273,6 +273,18 @@
 #define unlikely(x) ((x) != 0)
 #endif
 
+/*
+ * Hint to the CPU that the memory at address "a" is going to be read soon,
+ * so that a cache miss can overlap with other work.  The address needn't be
+ * valid; no fault is raised.  Only useful in memory-latency-bound loops
+ * that can compute addresses well ahead of their use.
+ */
+#if __GNUC__ >= 3
+#define pg_prefetch_mem(a)	__builtin_prefetch(a)
+#else
+#define pg_prefetch_mem(a)	((void) 0)
+#endif
+
 /*
  * CppAsString
  *		Convert the argument to a string, using the C preprocessor.
@@ -104,13 +104,37 @@ typedef enum ExprEvalOp
 	/*
 	 * Evaluate function call (including OpExprs etc).  For speed, we
 	 * distinguish in the opcode whether the function is strict and/or
-	 * requires usage stats tracking.
+	 * requires usage stats tracking.  Strict functions with one or two
+	 * arguments, which covers nearly all operators, get their own opcodes
+	 * so the argument NULL checks don't need a loop.
 	 */
 	EEOP_FUNCEXPR,
 	EEOP_FUNCEXPR_STRICT,
+	EEOP_FUNCEXPR_STRICT_1,
+	EEOP_FUNCEXPR_STRICT_2,
 	EEOP_FUNCEXPR_FUSAGE,
 	EEOP_FUNCEXPR_STRICT_FUSAGE,
 
+	/*
+	 * Inlined versions of the int4 and int8 comparison functions, chosen
+	 * instead of EEOP_FUNCEXPR_STRICT_2 when the function is one of those
+	 * built-ins.  Arguments are evaluated into the fcinfo like for other
+	 * function calls, but the comparison is done without calling through
+	 * fmgr.
+	 */
+	EEOP_INT4_EQ,
+	EEOP_INT4_NE,
+	EEOP_INT4_LT,
+	EEOP_INT4_LE,
+	EEOP_INT4_GT,
+	EEOP_INT4_GE,
+	EEOP_INT8_EQ,
+	EEOP_INT8_NE,
+	EEOP_INT8_LT,
+	EEOP_INT8_LE,
+	EEOP_INT8_GT,
+	EEOP_INT8_GE,
+
 	/*
 	 * Evaluate boolean AND expression, one step per subexpression. FIRST/LAST
 	 * subexpressions are special-cased for performance.  Since AND always has
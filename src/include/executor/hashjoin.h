@@ -14,6 +14,7 @@
 #ifndef HASHJOIN_H
 #define HASHJOIN_H
 
+#include "lib/bloomfilter.h"
 #include "nodes/execnodes.h"
 #include "port/atomics.h"
 #include "storage/barrier.h"
@@ -80,6 +81,16 @@ typedef struct HashJoinTupleData
 #define HJTUPLE_MINTUPLE(hjtup)  \
 	((MinimalTuple) ((char *) (hjtup) + HJTUPLE_OVERHEAD))
 
+/*
+ * Bucket tags: each bucket's tag has one of eight bits set for each tuple in
+ * the bucket, chosen by the top three bits of the tuple's hash value (the
+ * low bits choose the bucket).  Tags are only kept for large, non-shared
+ * hash tables, where probing buckets that can't contain a match is most
+ * likely to miss the CPU caches.
+ */
+#define HJ_BUCKET_TAG(hashvalue)	((uint8) (1 << ((hashvalue) >> 29)))
+#define HJ_BUCKET_TAGS_MIN_BUCKETS	(1 << 16)
+
 /*
  * If the outer relation's distribution is sufficiently nonuniform, we attempt
  * to optimize the join by treating the hash values corresponding to the outer
@@ -299,6 +310,21 @@ typedef struct HashJoinTableData
 		dsa_pointer_atomic *shared;
 	}			buckets;
 
+	/*
+	 * bucketTags[i] summarizes the hash values of the tuples in i'th
+	 * unshared bucket, so that probes can skip buckets without a possible
+	 * match without reading the bucket header or its tuples.  NULL if not
+	 * used.  See ExecHashBuildBucketTags().
+	 */
+	uint8	   *bucketTags;
+
+	/*
+	 * Bloom filter over the hash values of all inner tuples, in every batch,
+	 * handed to the outer scan as a runtime filter.  NULL if not used.  See
+	 * ExecHashTableInitRuntimeFilter().
+	 */
+	bloom_filter *runtimeFilter;
+
 	bool		keepNulls;		/* true to store unmatchable NULL tuples */
 
 	bool		skewEnabled;	/* are we using skew optimization? */
@@ -344,6 +370,7 @@ typedef struct HashJoinTableData
 	Size		spacePeak;		/* peak space used */
 	Size		spaceUsedSkew;	/* skew hash table's current space usage */
 	Size		spaceAllowedSkew;	/* upper limit for skew hashtable */
+	Size		spaceRuntimeFilter; /* space taken by runtimeFilter */
 
 	MemoryContext hashCxt;		/* context for whole-hash-join storage */
 	MemoryContext batchCxt;		/* context for this-batch-only storage */
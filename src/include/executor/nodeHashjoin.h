@@ -28,6 +28,9 @@ extern void ExecHashJoinReInitializeDSM(HashJoinState *state, ParallelContext *p
 extern void ExecHashJoinInitializeWorker(HashJoinState *state,
 										 ParallelWorkerContext *pwcxt);
 
+extern bool ExecHashJoinRuntimeFilter(HashJoinState *hjstate,
+									  TupleTableSlot *slot);
+
 extern void ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue,
 								  BufFile **fileptr);
 
@@ -145,6 +145,7 @@ typedef struct ExprState
  *		CheckedUnchanged	IndexUnchanged status determined yet?
  *		IndexUnchanged		aminsert hint, cached for retail inserts
  *		Concurrent			are we doing a concurrent index build?
+ *		Summarizing			is it a summarizing index (see amsummarizing)?
  *		BrokenHotChain		did we detect any broken HOT chains?
  *		ParallelWorkers		# of workers requested (excludes leader)
  *		Am					Oid of index AM
@@ -179,6 +180,7 @@ typedef struct IndexInfo
 	bool		ii_IndexUnchanged;
 	bool		ii_Concurrent;
 	bool		ii_BrokenHotChain;
+	bool		ii_Summarizing;
 	int			ii_ParallelWorkers;
 	Oid			ii_Am;
 	void	   *ii_AmCache;
@@ -1434,6 +1436,15 @@ typedef struct SeqScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
 	Size		pscan_len;		/* size of parallel heap scan descriptor */
+	Bitmapset  *proj_attrs;		/* columns needed from the table */
+
+	/*
+	 * A parent hash join can ask us to drop tuples that its runtime filter
+	 * proves have no join partner; see ExecSeqScanSetRuntimeFilter().
+	 */
+	struct HashJoinState *runtime_filter;	/* filtering join, or NULL */
+	ExecProcNodeMtd runtime_filter_next;	/* unfiltered ExecProcNode */
+	bool		runtime_filter_used;	/* was a runtime filter ever set? */
 } SeqScanState;
 
 /* ----------------
@@ -2067,6 +2078,15 @@ typedef struct HashJoinState
 	int			hj_JoinState;
 	bool		hj_MatchedOuter;
 	bool		hj_OuterNotEmpty;
+	/* outer tuples read ahead, see ExecHashJoinPrefetchOuter() */
+	TupleTableSlot **hj_PrefetchSlots;
+	uint32	   *hj_PrefetchHashValues;
+	int			hj_PrefetchCount;	/* # of tuples read ahead */
+	int			hj_PrefetchNext;	/* index of next one to return */
+	/* runtime filter state, see ExecHashJoinRuntimeFilter() */
+	ExprContext *hj_RuntimeFilterContext;	/* NULL if not eligible */
+	uint64		hj_RuntimeFilterChecked;
+	uint64		hj_RuntimeFilterRemoved;
 } HashJoinState;
 
 
@@ -2290,6 +2310,11 @@ typedef struct AggregateInstrumentation
 	Size		hash_mem_peak;	/* peak hash table memory usage */
 	uint64		hash_disk_used; /* kB of disk space used */
 	int			hash_batches_used;	/* batches used during entire execution */
+	int			hash_flushes;	/* times the table was emitted early */
+	int			hash_spill_depth;	/* deepest recursion of spilled batches */
+	int64		hash_smallest_batch;	/* tuples in smallest spilled batch */
+	int64		hash_largest_batch; /* tuples in largest spilled batch */
+	int64		hash_spilled_tuples;	/* tuples in all spilled batches */
 } AggregateInstrumentation;
 
 /* ----------------
@@ -2396,6 +2421,16 @@ typedef struct AggState
 										 * ->hash_pergroup */
 	ProjectionInfo *combinedproj;	/* projection machinery */
 	SharedAggInfo *shared_info; /* one entry per worker */
+	/* input read ahead by agg_prefetch_hash_input(), if used */
+	TupleTableSlot **hash_prefetch_slots;
+	uint32	   *hash_prefetch_hashes;
+	bool		hash_flush_pending; /* partial agg: emit the table, then
+									 * continue reading input */
+	int			hash_flushes;	/* times the table was emitted early */
+	int			hash_spill_depth;	/* deepest recursion of spilled batches */
+	int64		hash_smallest_batch;	/* tuples in smallest spilled batch */
+	int64		hash_largest_batch; /* tuples in largest spilled batch */
+	int64		hash_spilled_tuples;	/* tuples in all spilled batches */
 } AggState;
 
 /* ----------------
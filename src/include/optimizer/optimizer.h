@@ -110,6 +110,7 @@ typedef enum
 /* GUC parameters */
 extern PGDLLIMPORT int force_parallel_mode;
 extern PGDLLIMPORT bool parallel_leader_participation;
+extern PGDLLIMPORT int parallel_leader_merge_only_workers;
 
 extern struct PlannedStmt *planner(Query *parse, const char *query_string,
 								   int cursorOptions,
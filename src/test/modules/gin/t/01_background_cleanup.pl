@@ -0,0 +1,63 @@
+
+# Copyright (c) 2022, PostgreSQL Global Development Group
+
+# Verify that GIN pending list cleanup can be left to autovacuum
+
+use strict;
+use warnings;
+
+use PostgreSQL::Test::Utils;
+use Test::More;
+use PostgreSQL::Test::Cluster;
+
+my $node = PostgreSQL::Test::Cluster->new('tango');
+$node->init;
+# Keep autovacuum away until we want it to process the queued work item
+$node->append_conf('postgresql.conf', 'autovacuum_naptime = 1h');
+$node->start;
+
+$node->safe_psql('postgres', 'create extension pageinspect');
+
+# With a 64kB limit, the list is cleaned up once it has more than 8 pages.
+# 4000 rows make about 20 pages, less than the 32 at which the inserting
+# session would clean up the list anyway.
+my $pending = $node->safe_psql(
+	'postgres',
+	"create table gin_wi (a int4[]);
+	 create index gin_wi_idx on gin_wi using gin (a)
+	   with (fastupdate = on, gin_pending_list_limit = 64,
+			 background_cleanup = on);
+	 insert into gin_wi select array[1, g] from generate_series(1, 4000) g;
+	 select n_pending_pages
+	   from gin_metapage_info(get_raw_page('gin_wi_idx', 0));");
+cmp_ok($pending, '>', 8, "insertions left the cleanup to autovacuum");
+
+# Autovacuum can't clean up temporary indexes, so their inserters do it
+$pending = $node->safe_psql(
+	'postgres',
+	"create temp table gin_wi_temp (a int4[]);
+	 create index gin_wi_temp_idx on gin_wi_temp using gin (a)
+	   with (fastupdate = on, gin_pending_list_limit = 64,
+			 background_cleanup = on);
+	 insert into gin_wi_temp select array[1, g] from generate_series(1, 4000) g;
+	 select n_pending_pages
+	   from gin_metapage_info(get_raw_page('gin_wi_temp_idx', 0));");
+cmp_ok($pending, '<=', 8,
+	"insertions cleaned up the pending list of a temporary index");
+
+# Let autovacuum run, and wait for it to process the queued work item
+$node->append_conf('postgresql.conf', 'autovacuum_naptime = 1s');
+$node->reload;
+$node->poll_query_until(
+	'postgres',
+	"select n_pending_pages = 0
+	   from gin_metapage_info(get_raw_page('gin_wi_idx', 0))",
+	't');
+
+$pending = $node->safe_psql('postgres',
+	"select n_pending_pages from gin_metapage_info(get_raw_page('gin_wi_idx', 0))"
+);
+is($pending, '0', "autovacuum cleaned up the pending list");
+$node->stop;
+
+done_testing();
@@ -0,0 +1,60 @@
+
+# Copyright (c) 2022, PostgreSQL Global Development Group
+
+# Verify that a hash index built by sorting can use parallel workers
+
+use strict;
+use warnings;
+use PostgreSQL::Test::Cluster;
+use PostgreSQL::Test::Utils;
+use Test::More;
+
+my $node = PostgreSQL::Test::Cluster->new('main');
+$node->init;
+# The build sorts if the index has at least as many buckets as there are
+# shared buffers, and a worker needs 32MB of maintenance_work_mem.  With
+# 128 buffers, 100000 rows are enough to take the sorted path.
+$node->append_conf(
+	'postgresql.conf', qq{
+shared_buffers = 1MB
+max_connections = 10
+maintenance_work_mem = 64MB
+max_parallel_maintenance_workers = 1
+autovacuum = off
+trace_sort = on
+});
+$node->start;
+
+$node->safe_psql(
+	'postgres',
+	"create table hash_pb (x int4) with (parallel_workers = 1);
+	 insert into hash_pb select g from generate_series(1, 100000) g;
+	 vacuum analyze hash_pb;");
+
+my $log_offset = -s $node->logfile;
+
+$node->safe_psql('postgres',
+	'create index hash_pb_idx on hash_pb using hash (x)');
+
+# Each participant's partial sort logs its worker number, so a second
+# participant shows that a worker was launched
+my $log = slurp_file($node->logfile, $log_offset);
+like(
+	$log,
+	qr/performsort of worker 1 starting/,
+	'parallel worker sorted its share of the table');
+
+# Every row must be reachable through the index
+my $result = $node->safe_psql(
+	'postgres',
+	"set enable_seqscan = off;
+	 set enable_bitmapscan = off;
+	 set enable_hashjoin = off;
+	 set enable_mergejoin = off;
+	 select count(*) from generate_series(1, 100000) g
+	   where exists (select from hash_pb where x = g);");
+is($result, '100000', 'all rows found through the index');
+
+$node->stop;
+
+done_testing();
@@ -0,0 +1,26 @@
+-- Check which columns sequential scans ask a table AM for
+CREATE EXTENSION test_tableam;
+
+CREATE TABLE tt (a int, b text, c int) USING test_tableam;
+INSERT INTO tt VALUES (1, 'one', 11);
+
+-- target list only
+SELECT b FROM tt;
+-- columns referenced by quals are needed too
+SELECT a FROM tt WHERE c > 10;
+-- system columns are reported
+SELECT ctid, c FROM tt;
+-- whole-row references need all the columns
+SELECT tt FROM tt;
+-- no columns at all
+SELECT 1 FROM tt;
+
+-- dropped columns are not requested by a whole-row reference
+ALTER TABLE tt DROP COLUMN b;
+SELECT tt FROM tt;
+
+-- the scan underneath DELETE needs the row identity
+DELETE FROM tt WHERE a = 1;
+SELECT * FROM tt;
+
+DROP TABLE tt;
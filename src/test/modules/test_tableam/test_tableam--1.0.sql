@@ -0,0 +1,13 @@
+/* src/test/modules/test_tableam/test_tableam--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_tableam" to load this file. \quit
+
+CREATE FUNCTION test_tableam_handler(internal)
+RETURNS table_am_handler
+AS 'MODULE_PATHNAME'
+LANGUAGE C;
+
+-- Access method
+CREATE ACCESS METHOD test_tableam TYPE TABLE HANDLER test_tableam_handler;
+COMMENT ON ACCESS METHOD test_tableam IS 'heap with optional callbacks that report their arguments';
@@ -0,0 +1,71 @@
+/*--------------------------------------------------------------------------
+ *
+ * test_tableam.c
+ *		Heap-based table access method for testing optional callbacks.
+ *
+ * Copyright (c) 2022, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *		src/test/modules/test_tableam/test_tableam.c
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/heapam.h"
+#include "access/sysattr.h"
+#include "access/tableam.h"
+#include "fmgr.h"
+#include "lib/stringinfo.h"
+#include "nodes/bitmapset.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+
+PG_MODULE_MAGIC;
+
+PG_FUNCTION_INFO_V1(test_tableam_handler);
+
+static TableAmRoutine test_tableam_methods;
+
+/*
+ * Report the columns a sequential scan asked for, by name and in attribute
+ * number order.
+ */
+static void
+test_tableam_scan_set_column_projection(TableScanDesc scan, Bitmapset *attrs)
+{
+	Oid			relid = RelationGetRelid(scan->rs_rd);
+	StringInfoData buf;
+	int			x = -1;
+
+	initStringInfo(&buf);
+	while ((x = bms_next_member(attrs, x)) >= 0)
+	{
+		AttrNumber	attno = x + FirstLowInvalidHeapAttributeNumber;
+
+		if (buf.len > 0)
+			appendStringInfoString(&buf, ", ");
+		appendStringInfoString(&buf, get_attname(relid, attno, false));
+	}
+
+	ereport(NOTICE,
+			(errmsg("scan of \"%s\" projects columns: %s",
+					RelationGetRelationName(scan->rs_rd),
+					buf.len > 0 ? buf.data : "(none)")));
+
+	pfree(buf.data);
+}
+
+Datum
+test_tableam_handler(PG_FUNCTION_ARGS)
+{
+	/* Start from heap, and add the callbacks under test */
+	if (test_tableam_methods.type == 0)
+	{
+		test_tableam_methods = *GetHeapamTableAmRoutine();
+		test_tableam_methods.scan_set_column_projection =
+			test_tableam_scan_set_column_projection;
+	}
+
+	PG_RETURN_POINTER(&test_tableam_methods);
+}
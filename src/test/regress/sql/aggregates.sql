@@ -1260,3 +1260,62 @@ drop table agg_hash_1;
 drop table agg_hash_2;
 drop table agg_hash_3;
 drop table agg_hash_4;
+
+-- Once the hash table is large, its input is read and prefetched in groups
+set enable_sort = false;
+set work_mem = '64MB';
+select count(*), sum(c), count(*) filter (where c <> 3)
+  from (select g % 100000 as k, count(*) as c
+        from generate_series(1, 300000) g group by k) s;
+set enable_sort to default;
+set work_mem to default;
+
+-- A partial hash aggregate that runs out of memory emits its groups early
+-- instead of spilling them; the Finalize Aggregate combines them
+set work_mem = '64kB';
+set enable_sort = false;
+set parallel_setup_cost = 0;
+set parallel_tuple_cost = 0;
+set min_parallel_table_scan_size = 0;
+set max_parallel_workers_per_gather = 2;
+select count(*), sum(c), sum(s)
+  from (select g % 10000 as k, count(*) as c, sum(g) as s
+        from agg_data_20k group by k) x;
+reset max_parallel_workers_per_gather;
+reset min_parallel_table_scan_size;
+reset parallel_tuple_cost;
+reset parallel_setup_cost;
+set enable_sort to default;
+set work_mem to default;
+
+-- A hash aggregate that spills reports the depth and sizes of its batches
+create function hashagg_spill_info(query text,
+  out spilled bool, out has_spill_info bool,
+  out depth_ok bool, out sizes_ok bool)
+language plpgsql as
+$$
+declare
+  agg json;
+begin
+  execute 'explain (analyze, costs off, summary off, timing off, format json) '
+    || query into agg;
+  agg := agg->0->'Plan';
+  spilled := (agg->>'HashAgg Batches')::int > 1;
+  has_spill_info := agg->'HashAgg Spill Depth' is not null;
+  depth_ok := (agg->>'HashAgg Spill Depth')::int >= 1;
+  sizes_ok := (agg->>'HashAgg Min Batch Tuples')::int8 > 0 and
+    (agg->>'HashAgg Min Batch Tuples')::int8 <=
+      (agg->>'HashAgg Avg Batch Tuples')::int8 and
+    (agg->>'HashAgg Avg Batch Tuples')::int8 <=
+      (agg->>'HashAgg Max Batch Tuples')::int8;
+end;
+$$;
+set work_mem = '64kB';
+set enable_sort = false;
+select * from hashagg_spill_info(
+  'select g, count(*) from agg_data_20k group by g');
+set work_mem to default;
+select spilled, has_spill_info from hashagg_spill_info(
+  'select g, count(*) from agg_data_20k group by g');
+set enable_sort to default;
+drop function hashagg_spill_info(text);
@@ -515,3 +515,25 @@ CREATE UNLOGGED TABLE brintest_unlogged (n numrange);
 CREATE INDEX brinidx_unlogged ON brintest_unlogged USING brin (n);
 INSERT INTO brintest_unlogged VALUES (numrange(0, 2^1000::numeric));
 DROP TABLE brintest_unlogged;
+
+-- test inline summarization of filled page ranges
+CREATE TABLE brintest_inline (a int) WITH (fillfactor = 10);
+CREATE INDEX brinidx_inline ON brintest_inline USING brin (a)
+  WITH (pages_per_range = 1, inline_summarize = on);
+INSERT INTO brintest_inline SELECT generate_series(1, 1000);
+-- only the last range should be left unsummarized
+SELECT brin_summarize_new_values('brinidx_inline');
+
+-- test parallel build
+SET max_parallel_maintenance_workers = 2;
+SET min_parallel_table_scan_size = 0;
+CREATE INDEX brinidx_parallel ON brintest_inline USING brin (a)
+  WITH (pages_per_range = 1);
+RESET max_parallel_maintenance_workers;
+RESET min_parallel_table_scan_size;
+SELECT brin_summarize_new_values('brinidx_parallel'); -- ok, no change expected
+DROP INDEX brinidx_inline;
+SET enable_seqscan = off;
+SELECT count(*) FROM brintest_inline WHERE a BETWEEN 100 AND 200;
+RESET enable_seqscan;
+DROP TABLE brintest_inline;
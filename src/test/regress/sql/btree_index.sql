@@ -242,3 +242,68 @@ CREATE TABLE btree_part (id int4) PARTITION BY RANGE (id);
 CREATE INDEX btree_part_idx ON btree_part(id);
 ALTER INDEX btree_part_idx ALTER COLUMN id SET (n_distinct=100);
 DROP TABLE btree_part;
+
+--
+-- Test skipping over leaf pages when the index's first column isn't
+-- constrained but its second column is
+--
+CREATE TABLE btree_skip (a int, b int);
+INSERT INTO btree_skip SELECT i % 5, i FROM generate_series(1, 20000) i;
+CREATE INDEX btree_skip_idx ON btree_skip (a, b);
+VACUUM ANALYZE btree_skip;
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT a, b FROM btree_skip WHERE b = 4242;
+SELECT count(*) FROM btree_skip WHERE b BETWEEN 1000 AND 1999;
+SELECT count(*) FROM btree_skip WHERE b > 19990;
+SELECT count(*) FROM btree_skip WHERE b < 11;
+-- Check that the scan really skips, by comparing the buffers it touches with
+-- those of a backward scan, which never skips and so reads every leaf page
+CREATE FUNCTION btree_skip_buffers(query text) RETURNS int
+LANGUAGE plpgsql AS
+$$
+DECLARE
+    ln text;
+    m text[];
+BEGIN
+    FOR ln IN
+        EXECUTE 'EXPLAIN (ANALYZE, BUFFERS, COSTS OFF, TIMING OFF, SUMMARY OFF) ' || query
+    LOOP
+        m := regexp_match(ln, 'Buffers: shared(?: hit=(\d+))?(?: read=(\d+))?');
+        IF m IS NOT NULL THEN
+            RETURN coalesce(m[1]::int, 0) + coalesce(m[2]::int, 0);
+        END IF;
+    END LOOP;
+    RETURN NULL;
+END;
+$$;
+SELECT btree_skip_buffers('SELECT a, b FROM btree_skip WHERE b = 4242 ORDER BY a, b') * 2 <
+       btree_skip_buffers('SELECT a, b FROM btree_skip WHERE b = 4242 ORDER BY a DESC, b DESC')
+  AS skipped;
+-- A merge join's inner scan keeps skipping across mark and restore
+SET enable_hashjoin = off;
+SET enable_nestloop = off;
+SELECT count(*)
+  FROM (SELECT i % 5 AS a FROM generate_series(1, 10) i) o
+  JOIN btree_skip s ON s.a = o.a
+ WHERE s.b BETWEEN 1000 AND 1999;
+RESET enable_hashjoin;
+RESET enable_nestloop;
+-- Parallel scans never skip, so a partial path must not be costed as if it
+-- did; the serial scan should win even when parallelism is free
+SET max_parallel_workers_per_gather = 2;
+SET parallel_setup_cost = 0;
+SET parallel_tuple_cost = 0;
+SET min_parallel_table_scan_size = 0;
+SET min_parallel_index_scan_size = 0;
+EXPLAIN (COSTS OFF)
+SELECT a, b FROM btree_skip WHERE b = 4242;
+RESET max_parallel_workers_per_gather;
+RESET parallel_setup_cost;
+RESET parallel_tuple_cost;
+RESET min_parallel_table_scan_size;
+RESET min_parallel_index_scan_size;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+DROP FUNCTION btree_skip_buffers(text);
+DROP TABLE btree_skip;
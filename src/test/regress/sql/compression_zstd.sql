@@ -0,0 +1,27 @@
+-- Tests for TOAST compression with zstd
+
+-- ensure we get stable results regardless of installation's default
+SET default_toast_compression = 'pglz';
+
+CREATE TABLE cmdata_zstd(f1 TEXT COMPRESSION zstd);
+INSERT INTO cmdata_zstd VALUES(repeat('1234567890', 1004));
+SELECT pg_column_compression(f1) FROM cmdata_zstd;
+
+-- decompress data slice
+SELECT SUBSTR(f1, 200, 5) FROM cmdata_zstd;
+
+-- externally stored compressed data
+CREATE FUNCTION large_val_zstd() RETURNS TEXT LANGUAGE SQL AS
+'select array_agg(md5(g::text))::text from generate_series(1, 256) g';
+INSERT INTO cmdata_zstd SELECT large_val_zstd() || repeat('a', 4000);
+SELECT pg_column_compression(f1) FROM cmdata_zstd;
+SELECT SUBSTR(f1, 200, 5) FROM cmdata_zstd;
+SELECT length(f1) FROM cmdata_zstd;
+
+-- switching the column's method leaves existing data alone
+ALTER TABLE cmdata_zstd ALTER COLUMN f1 SET COMPRESSION pglz;
+INSERT INTO cmdata_zstd VALUES(repeat('123456789', 1004));
+SELECT pg_column_compression(f1) FROM cmdata_zstd;
+
+DROP TABLE cmdata_zstd;
+DROP FUNCTION large_val_zstd();
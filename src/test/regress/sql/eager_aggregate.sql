@@ -0,0 +1,35 @@
+--
+-- EAGER_AGGREGATE
+-- Test partial aggregation below a join
+--
+
+CREATE TABLE eager_fact (dim_id int, amount int);
+CREATE TABLE eager_dim (id int, name text);
+INSERT INTO eager_fact SELECT i % 10 + 1, i % 100 FROM generate_series(1, 10000) i;
+INSERT INTO eager_dim SELECT i, 'n' || (i % 5) FROM generate_series(1, 100) i;
+ANALYZE eager_fact, eager_dim;
+
+SET enable_eager_aggregate = on;
+
+-- The fact table is aggregated by its join key before the join
+EXPLAIN (COSTS OFF)
+SELECT d.name, sum(f.amount), count(*), avg(f.amount)
+  FROM eager_fact f JOIN eager_dim d ON f.dim_id = d.id
+  GROUP BY d.name ORDER BY d.name;
+SELECT d.name, sum(f.amount), count(*), avg(f.amount)
+  FROM eager_fact f JOIN eager_dim d ON f.dim_id = d.id
+  GROUP BY d.name ORDER BY d.name;
+
+-- Not possible when aggregates use columns from both sides
+EXPLAIN (COSTS OFF)
+SELECT d.name, sum(f.amount + d.id)
+  FROM eager_fact f JOIN eager_dim d ON f.dim_id = d.id
+  GROUP BY d.name;
+
+-- Same results without eager aggregation
+RESET enable_eager_aggregate;
+SELECT d.name, sum(f.amount), count(*), avg(f.amount)
+  FROM eager_fact f JOIN eager_dim d ON f.dim_id = d.id
+  GROUP BY d.name ORDER BY d.name;
+
+DROP TABLE eager_fact, eager_dim;
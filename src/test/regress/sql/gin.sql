@@ -181,3 +181,17 @@ values
   ('{}',    null),
   ('{1}',   '{2,3}');
 drop table t_gin_test_tbl;
+
+-- Test background pending list cleanup.  Whether autovacuum gets to the list
+-- first doesn't matter; searches must see all of the entries either way.
+create table gin_bg_tbl(i int4[]) with (autovacuum_enabled = off);
+create index gin_bg_idx on gin_bg_tbl using gin (i)
+  with (fastupdate = on, gin_pending_list_limit = 64, background_cleanup = on);
+insert into gin_bg_tbl select array[1, g] from generate_series(1, 10000) g;
+set enable_seqscan = off;
+select count(*) from gin_bg_tbl where i @> array[1];
+select count(*) from gin_bg_tbl where i @> array[5000];
+reset enable_seqscan;
+alter index gin_bg_idx set (background_cleanup = off);
+select gin_clean_pending_list('gin_bg_idx') >= 0 as ok;
+drop table gin_bg_tbl;
@@ -37,6 +37,20 @@ vacuum analyze gist_point_tbl;
 alter index gist_pointidx SET (fillfactor = 40);
 reindex index gist_pointidx;
 
+-- rebuild it once more using parallel workers, and check its contents
+set max_parallel_maintenance_workers = 2;
+set min_parallel_table_scan_size = 0;
+reindex index gist_pointidx;
+reset max_parallel_maintenance_workers;
+reset min_parallel_table_scan_size;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+select count(*) from gist_point_tbl
+where p <@ box(point(0, 0), point(100000, 100000));
+reset enable_seqscan;
+reset enable_bitmapscan;
+
 --
 -- Test Index-only plans on GiST indexes
 --
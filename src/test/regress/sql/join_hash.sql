@@ -556,3 +556,60 @@ WHERE
     AND hjtest_1.a <> hjtest_2.b;
 
 ROLLBACK;
+
+-- A hash join with a large outer SeqScan hands the scan a Bloom filter of
+-- the inner hash values, so that hopeless outer tuples are discarded early.
+BEGIN;
+SET LOCAL enable_mergejoin = off;
+SET LOCAL enable_nestloop = off;
+SET LOCAL max_parallel_workers_per_gather = 0;
+CREATE TABLE hjrf_outer AS SELECT generate_series(1, 100000) AS id;
+CREATE TABLE hjrf_inner AS SELECT g * 1000 AS id FROM generate_series(1, 10) g;
+ANALYZE hjrf_outer, hjrf_inner;
+
+-- Report what the outer scan of a hash join returned and filtered.
+CREATE FUNCTION hjrf_outer_scan(query text,
+  OUT returned int, OUT filtered bool, OUT removed int)
+LANGUAGE plpgsql AS
+$$
+DECLARE
+  whole_plan json;
+  scan json;
+BEGIN
+  EXECUTE 'EXPLAIN (ANALYZE, FORMAT ''json'') ' || query INTO whole_plan;
+  scan := json_extract_path(whole_plan, '0', 'Plan', 'Plans', '0', 'Plans', '0');
+  returned := scan->>'Actual Rows';
+  filtered := scan->'Rows Removed by Runtime Filter' IS NOT NULL;
+  removed := scan->>'Rows Removed by Runtime Filter';
+END;
+$$;
+
+-- the first outer tuple is fetched before the hash table is built
+SELECT * FROM hjrf_outer_scan(
+  'SELECT count(*) FROM hjrf_outer o JOIN hjrf_inner i USING (id)');
+SELECT count(*) FROM hjrf_outer o JOIN hjrf_inner i USING (id);
+SELECT count(*) FROM hjrf_outer o WHERE id IN (SELECT id FROM hjrf_inner);
+-- no filter when unmatched outer tuples must be kept
+SELECT returned, filtered FROM hjrf_outer_scan(
+  'SELECT count(*) FROM hjrf_outer o LEFT JOIN hjrf_inner i USING (id)');
+-- nor when the filter doesn't fit in hash_mem next to the table
+SET LOCAL work_mem = '64kB';
+SELECT returned, filtered FROM hjrf_outer_scan(
+  'SELECT count(*) FROM hjrf_outer o JOIN hjrf_inner i USING (id)');
+
+ROLLBACK;
+
+-- Probing a hash table too big for the cache reads outer tuples in groups
+BEGIN;
+SET LOCAL work_mem = '64MB';
+SET LOCAL enable_mergejoin = off;
+SET LOCAL enable_nestloop = off;
+SET LOCAL max_parallel_workers_per_gather = 0;
+CREATE TABLE hjpf_inner AS
+  SELECT g AS id, repeat('x', 20) AS pad FROM generate_series(1, 100000) g;
+CREATE TABLE hjpf_outer AS
+  SELECT g % 150000 AS id FROM generate_series(1, 300000) g;
+ANALYZE hjpf_inner, hjpf_outer;
+SELECT count(*), count(DISTINCT i.id), sum(length(i.pad))
+  FROM hjpf_outer o JOIN hjpf_inner i USING (id);
+ROLLBACK;
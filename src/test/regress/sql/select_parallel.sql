@@ -238,6 +238,10 @@ begin
 end;
 $$;
 select * from explain_parallel_sort_stats();
+-- with enough workers, the leader can be left to merging
+set parallel_leader_merge_only_workers = 4;
+select * from explain_parallel_sort_stats();
+reset parallel_leader_merge_only_workers;
 
 reset enable_indexscan;
 reset enable_hashjoin;
@@ -462,3 +466,61 @@ SELECT 1 FROM tenk1_vw_sec
   WHERE (SELECT sum(f1) FROM int4_tbl WHERE f1 < unique1) < 100;
 
 rollback;
+
+-- test parallel B-tree scans that divide the key range into chunks up front.
+-- That needs a root page at level 2 or above, which wide keys and a small
+-- fillfactor give us with few rows.  Compare with serial scans, also in the
+-- backward direction, where the scan isn't divided.
+create table btchunk (id int, k text);
+insert into btchunk
+  select i, lpad(i::text, 4, '0') || repeat('x', 476)
+  from generate_series(1, 300) i;
+create index btchunk_k on btchunk (k) with (fillfactor = 10);
+vacuum analyze btchunk;
+alter table btchunk set (parallel_workers = 4);
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k offset 0) s;
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k desc offset 0) s;
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k offset 0) s;
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k desc offset 0) s;
+
+set parallel_setup_cost = 0;
+set parallel_tuple_cost = 0;
+set min_parallel_index_scan_size = 0;
+set max_parallel_workers_per_gather = 4;
+
+explain (costs off)
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k offset 0) s;
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k offset 0) s;
+explain (costs off)
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k desc offset 0) s;
+select count(*), sum(id), md5(string_agg(id::text, ','))
+  from (select id from btchunk where k > '0057' order by k desc offset 0) s;
+explain (costs off)
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k offset 0) s;
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k offset 0) s;
+explain (costs off)
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k desc offset 0) s;
+select md5(string_agg(left(k, 4), ','))
+  from (select k from btchunk where k > '0057' order by k desc offset 0) s;
+
+reset enable_seqscan;
+reset enable_bitmapscan;
+reset parallel_setup_cost;
+reset parallel_tuple_cost;
+reset min_parallel_index_scan_size;
+reset max_parallel_workers_per_gather;
+drop table btchunk;
@@ -442,5 +442,29 @@ SET enable_seqscan TO on;
 SELECT pg_stat_get_replication_slot(NULL);
 SELECT pg_stat_get_subscription_stats(NULL);
 
+-- Test that BRIN indexes don't prevent HOT updates, but are still
+-- updated when their columns change
+CREATE TABLE brin_hot (
+  id  integer PRIMARY KEY,
+  val integer NOT NULL
+) WITH (autovacuum_enabled = off, fillfactor = 70);
+
+INSERT INTO brin_hot SELECT *, 0 FROM generate_series(1, 235);
+CREATE INDEX val_brin ON brin_hot using brin(val);
+
+UPDATE brin_hot SET val = -3 WHERE id = 42;
+
+-- ensure pending stats are flushed
+SELECT pg_stat_force_next_flush();
+
+SELECT pg_stat_get_tuples_hot_updated('brin_hot'::regclass::oid);
+
+-- the BRIN summary must cover the new value
+SET enable_seqscan TO off;
+SELECT id FROM brin_hot WHERE val < 0;
+RESET enable_seqscan;
+
+DROP TABLE brin_hot;
+
 
 -- End of Stats Test